@@ -3,21 +3,45 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <stdatomic.h> // 관전 방송 seqlock, 게임 기록 링 버퍼
+#include <signal.h> // Ctrl-C 등 종료 신호 처리, kill()
 
 // Windows 환경 감지
 #ifdef _WIN32
-    #include <windows.h> // Sleep(), system("cls") 등 사용
+    #include <windows.h> // Sleep(), system("cls"), CreateThread() 등 사용
     #include <conio.h> // getch(), kbhit() 등 사용
 // Linux 또는 macOS 환경
 #else // WIN32 매크로가 정의되지 않음 -> Linux/Mac 환경일때 정의됨
     #include <unistd.h> // usleep(), read() 등 사용
     #include <termios.h> // 터미널 속성 제어(버퍼링/에코 비활성화 등)
     #include <fcntl.h> // 논블로킹 입력 등
+    #include <sys/mman.h> // shm_open(), mmap() : 관전 방송용 공유 메모리
+    #include <sys/stat.h> // fstat()
+    #include <pthread.h> // 게임 기록 쓰기 스레드
+    #include <dirent.h> // 관전할 방송 찾기
+    #include <errno.h>
 #endif // 운영체제 분기 종료
 
+#include "stage_data.h" // 빌드 시 내장되는 스테이지 데이터 형식
+#include "telemetry.h" // 게임 기록 파일 형식
+
+// 메모리 할당 추적 (디버그용, 기본 꺼짐)
+// -DMEM_TRACK : 할당 횟수/바이트, 최대 힙/스택 사용량을 구역별로 세서 종료 시 출력
+// -DMEM_ASSERT : 추적 + 첫 프레임 이후 메인 루프에서 힙 할당이 일어나면 즉시 중단
+#ifdef MEM_ASSERT
+    #define MEM_TRACK
+#endif
+#ifdef MEM_TRACK
+    #ifndef __GLIBC__
+        #error "MEM_TRACK은 glibc(Linux) 환경에서만 지원합니다."
+    #endif
+    #include <malloc.h> // malloc_usable_size()
+#endif
+
 // 맵 및 게임 요소 정의 (수정된 부분)
 #define MAX_ENEMIES 15 // 최대 적 개수 증가
 #define MAX_COINS 30   // 최대 코인 개수 증가
+#define MAP_LIMIT 256 // 맵 최대 너비, 높이
 
 // 구조체 정의
 // 적 정보
@@ -40,15 +64,30 @@ typedef enum {
     sound_GAMEOVER // 게임 오버
 } Play;
 
+// 화면 한 줄 (맵 최대 너비 + 개행)
+typedef char FrameRow[MAP_LIMIT + 1];
+
+// 메모리 추적 구역 정의
+typedef enum {
+    mem_MAIN, // 그 외 (main, 타이틀, 입력 등)
+    mem_LOADER, // 맵 로드
+    mem_STAGE, // 스테이지 초기화
+    mem_RENDER, // 화면 그리기
+    mem_AUDIO, // 사운드
+    mem_ZONE_COUNT
+} MemZone;
+
 // 전역 변수
-char ***map; // 3차원 배열 포인터 (stage, y, x)
+const char *const *const *map = NULL; // 현재 사용 중인 맵 (stage, y, x), 읽기 전용
+char ***loaded_map = NULL; // map.txt에서 읽어 동적 할당한 맵
+const StageData *stage_table = NULL; // 내장 맵 사용 시 미리 계산된 오브젝트 테이블
 // 맵,스테이지 크기 전역 변수 선언
 int map_width = 0; // 맵 가로 길이
 int map_height = 0; // 맵 세로 길이
 int MAX_STAGES = 0; // 전체 스테이지 개수
 // 맵 제한 크기
-int limit_width = 256;
-int limit_height = 256;
+int limit_width = MAP_LIMIT;
+int limit_height = MAP_LIMIT;
 // 플레이어 상태 관련 전역 변수
 int player_x, player_y; // 플레이어 현재 좌표
 int stage = 0; // 현재 스테이지
@@ -65,11 +104,110 @@ Enemy enemies[MAX_ENEMIES]; // 적 배열
 int enemy_count = 0; // 현재 스테이지의 적 개수
 Coin coins[MAX_COINS]; // 코인 배열
 int coin_count = 0; // 코인 개수
+// 먹은 코인 기록 : 맵을 수정하지 않고 같은 스테이지 재시작 시에도 먹은 코인 유지
+int coin_taken[MAX_COINS]; // coins[i]를 먹었는지 여부
+int coin_stage = -1; // coin_taken이 기록 중인 스테이지 (-1: 기록 없음)
+
+// 표준 입출력 버퍼 : 첫 입출력 때 힙에 할당되지 않도록 미리 정적 버퍼 지정
+char stdout_buf[16384];
+char stdin_buf[256];
+
+// 종료 신호 : Ctrl-C 등으로 바로 죽으면 atexit 처리(게임 기록 저장, 방송 제거)가 실행되지 않으므로
+// 신호를 받으면 표시만 해 두고 게임 루프가 q를 누른 것처럼 정상 종료함
+volatile sig_atomic_t quit_signal = 0; // 1: 종료 신호를 받음
+
+// 게임 기록 (--telemetry <파일>)
+// 위치 카운터는 틱마다 메모리에서만 올리고, 이벤트는 고정 크기 링 버퍼에 넣으면
+// 쓰기 스레드가 모아서 파일 끝에 이어 씀 (게임 루프는 파일 입출력을 하지 않음)
+#define TELEMETRY_RING 4096 // 이벤트 링 버퍼 크기 (2의 거듭제곱)
+#define TELEMETRY_FLUSH_MS 200 // 쓰기 스레드가 버퍼를 비우는 간격
+int telemetry_on = 0; // 1: 기록 중
+FILE *telemetry_file = NULL; // 기록 파일
+char telemetry_file_buf[16384]; // 기록 파일 버퍼 (쓰기 스레드에서 지연 할당되지 않도록 정적 버퍼)
+TelemetryRecord telemetry_ring[TELEMETRY_RING]; // 이벤트 링 버퍼
+atomic_uint telemetry_head; // 게임이 다음에 넣을 위치
+atomic_uint telemetry_tail; // 쓰기 스레드가 다음에 쓸 위치
+atomic_int telemetry_running; // 0이 되면 쓰기 스레드 종료
+unsigned long telemetry_dropped = 0; // 버퍼가 가득 차서 버린 이벤트 수
+uint32_t *heatmap = NULL; // 스테이지별 위치 카운터 [stage][y][x]
+unsigned long game_tick = 0; // 게임 루프 틱 수
+#ifdef _WIN32
+    HANDLE telemetry_thread;
+#else
+    pthread_t telemetry_thread;
+#endif
+
+#ifdef MEM_TRACK
+    // 구역별 메모리 사용 통계
+    typedef struct {
+        unsigned long allocs; // 할당 횟수
+        unsigned long frees; // 이 구역에서 할당한 블록이 해제된 횟수
+        size_t bytes; // 누적 할당 바이트
+        size_t live; // 이 구역에서 할당해서 아직 해제되지 않은 바이트
+        size_t heap_peak; // live의 최댓값
+        size_t stack_peak; // 이 구역 실행 중 최대 스택 깊이 (main 기준)
+    } MemStat;
+    // 블록 -> 할당 구역 표 : 해제할 때 할당한 구역의 사용량을 줄이기 위해 기록
+    // 할당 함수 안에서 다시 할당할 수 없으므로 고정 크기 열린 주소 해시 표 사용
+    #define MEM_TABLE_SIZE 65536 // 동시에 추적할 수 있는 최대 블록 수 (2의 거듭제곱)
+    typedef struct {
+        void *ptr; // NULL: 빈 칸
+        size_t size; // malloc_usable_size
+        MemZone zone; // 할당한 구역
+    } MemBlock;
+    MemBlock mem_blocks[MEM_TABLE_SIZE];
+    atomic_flag mem_lock = ATOMIC_FLAG_INIT; // 표와 통계 보호 (쓰기 스레드도 할당할 수 있음)
+    unsigned long mem_untracked = 0; // 표가 가득 차서 구역을 기록하지 못한 할당 수
+    MemStat mem_stats[mem_ZONE_COUNT];
+    MemZone mem_zone = mem_MAIN; // 현재 실행 중인 구역
+    size_t heap_in_use = 0; // 현재 사용 중인 힙
+    size_t heap_peak = 0; // 최대 힙 사용량
+    // 스택 칠하기 : 구역에 들어갈 때 현재 스택 아래를 무늬로 채워 두고, 나중에 무늬가 지워진
+    // 가장 깊은 곳을 찾아 그 사이 실제로 쓰인 최대 깊이를 잼 (함수 안의 큰 지역 배열도 잡힘)
+    #define STACK_PAINT_SIZE (256 * 1024) // 칠하는 범위 : 이보다 깊이 쓰면 범위 끝까지로 기록
+    #define STACK_PAINT 0x5AA5C33CA55A3CC3ULL // 칠하는 무늬
+    char *stack_base = NULL; // main 시작 시점의 스택 위치
+    uintptr_t stack_paint_low = 0; // 칠한 범위 (낮은 주소 쪽 끝, 0: 아직 칠하지 않음)
+    uintptr_t stack_paint_high = 0; // 칠한 범위 (높은 주소 쪽 끝)
+    int mem_steady = 0; // 1: 첫 프레임 이후 메인 루프 실행 중
+    unsigned long steady_allocs = 0; // 메인 루프 중 일어난 할당 횟수
+#endif
 
 // Linux와 macOS 환경에서 사용할 터미널 설정
 #ifndef _WIN32
     // 터미널 설정
     struct termios orig_termios;
+
+    // 관전 방송 : 게임이 그린 화면을 공유 메모리 링 버퍼에 올리면 관전자가 읽어서 표시
+    // 슬롯마다 seqlock(홀수: 쓰는 중, 짝수: 완성)을 두어 게임은 관전자를 기다리지 않음
+    // 게임마다 "/nuguri.<PID>" 이름으로 따로 방송하므로 여러 게임이 동시에 실행되어도 서로 지우지 않음
+    #define BROADCAST_PREFIX "/nuguri." // 공유 메모리 이름 앞부분 (뒤에 게임 PID)
+    #define BROADCAST_MAGIC 0x4E475249 // "NGRI"
+    #define BROADCAST_SLOTS 4 // 링 버퍼 슬롯 수
+    #define BROADCAST_HEADER_SIZE 64 // 헤더 영역 크기 (슬롯은 그 뒤부터 시작)
+
+    // 공유 메모리 앞부분 : 맵 크기와 최신 슬롯 번호 (BROADCAST_HEADER_SIZE 안에 들어가야 함)
+    typedef struct {
+        _Atomic unsigned magic; // 초기화가 끝나면 BROADCAST_MAGIC
+        _Atomic int alive; // 1: 게임 실행 중, 0: 종료
+        int pid; // 방송하는 게임의 PID (비정상 종료로 남은 방송 판별용)
+        _Atomic unsigned latest; // 마지막으로 완성된 슬롯 번호
+        int width, height; // 맵 크기
+        int slot_count; // 슬롯 수
+        int slot_size; // 슬롯 하나의 바이트 수
+    } BroadcastHeader;
+
+    // 슬롯 하나 : HUD 정보 뒤에 height개의 FrameRow가 이어짐
+    typedef struct {
+        _Atomic unsigned seq; // seqlock 순번
+        int stage, score, life; // HUD
+        FrameRow rows[]; // 화면 (display_map과 같은 형식)
+    } BroadcastSlot;
+
+    BroadcastHeader *broadcast = NULL; // 게임 쪽 공유 메모리 (NULL: 방송 안 함)
+    char broadcast_name[32]; // 이 프로세스가 만든 공유 메모리 이름
+    size_t broadcast_size = 0; // 매핑 크기
+    unsigned broadcast_slot = 0; // 지금 쓰는 슬롯 번호
 #endif
 
 // 함수 선언
@@ -77,7 +215,9 @@ int coin_count = 0; // 코인 개수
 void disable_raw_mode();
 void enable_raw_mode();
 // 맵 및 스테이지 처리
-void load_maps();
+char *read_line(char *buf, int size, FILE *file);
+void load_maps(const char *path);
+void use_embedded_maps();
 void init_stage();
 void free_maps();
 // 게임 루프와 화면 처리
@@ -101,15 +241,76 @@ void game_over();
 void ending();
 // 사운드 함수
 void playsound(Play type);
+// 관전 방송
+void broadcast_open();
+void broadcast_close();
+FrameRow *broadcast_begin();
+void broadcast_end();
+void spectate(int pid);
+// 종료 신호
+void quit_handler(int sig);
+void catch_quit_signals();
+// 게임 기록
+void telemetry_open(const char *path);
+void telemetry_close();
+void telemetry_tick();
+void telemetry_event(TelemetryType type, int x, int y);
+// 메모리 추적
+#ifdef MEM_TRACK
+    MemZone mem_enter(MemZone zone);
+    void mem_leave(MemZone prev);
+    void mem_report();
+#else
+    #define mem_enter(zone) mem_MAIN // 추적하지 않을 때는 아무 일도 하지 않음
+    #define mem_leave(prev) ((void)(prev))
+#endif
+
+int main(int argc, char *argv[]) {
+    // 실행 인자 : -m, --map <파일> 로 맵 파일 지정, --telemetry <파일> 로 게임 기록, --spectate [PID] 로 관전 모드
+    const char *map_path = NULL;
+    const char *telemetry_path = NULL;
+    int spectate_mode = 0;
+    int spectate_pid = 0; // 관전할 게임의 PID (0: 실행 중인 게임을 찾음)
+    for (int i = 1; i < argc; i++) {
+        if ((strcmp(argv[i], "-m") == 0 || strcmp(argv[i], "--map") == 0) && i + 1 < argc) {
+            map_path = argv[++i];
+        } else if (strcmp(argv[i], "--telemetry") == 0 && i + 1 < argc) {
+            telemetry_path = argv[++i];
+        } else if (strcmp(argv[i], "--spectate") == 0) {
+            spectate_mode = 1;
+            if (i + 1 < argc && argv[i + 1][0] >= '1' && argv[i + 1][0] <= '9') spectate_pid = atoi(argv[++i]);
+        }
+    }
+
+    // 입출력 버퍼를 정적 버퍼로 지정 (지연 할당 방지)
+    setvbuf(stdout, stdout_buf, _IOLBF, sizeof(stdout_buf));
+    setvbuf(stdin, stdin_buf, _IOFBF, sizeof(stdin_buf));
+    #ifdef MEM_TRACK
+        char stack_top; // 스택 깊이 측정 기준점
+        stack_base = &stack_top;
+        atexit(mem_report); // 종료 시 통계 출력
+    #endif
 
-int main() {
     // Windows 콘솔을 UTF-8 모드로 설정 : 한글 깨짐 방지
     #ifdef _WIN32
         SetConsoleOutputCP(65001); // UTF-8 출력
         SetConsoleCP(65001); // UTF-8 입력
     #endif
+    catch_quit_signals(); // Ctrl-C로 끝내도 정상 종료 경로를 거치도록
+    if (spectate_mode) {
+        spectate(spectate_pid); // 다른 터미널에서 실행 중인 게임 관전
+        return 0;
+    }
     srand(time(NULL)); // 랜덤 시드 설정 (적 방향 랜덤 초기화 등에 사용)
-    load_maps(); // map.txt를 읽어서 맵과 스테이지 정보 동적 할당
+    #ifdef EMBED_MAPS
+        // 내장 맵 빌드 : 맵 파일을 지정한 경우에만 파일에서 읽음
+        if (map_path) load_maps(map_path);
+        else use_embedded_maps();
+    #else
+        load_maps(map_path ? map_path : "map.txt"); // map.txt를 읽어서 맵과 스테이지 정보 동적 할당
+    #endif
+    broadcast_open(); // 관전 방송 시작 (실패하면 방송 없이 진행)
+    if (telemetry_path) telemetry_open(telemetry_path); // 게임 기록 시작
     title(); // 타이틀 화면
     init_stage(); // 현재 스테이지 기준 플레이어, 적, 코인 위치 초기화
 
@@ -117,7 +318,7 @@ int main() {
     int game_over = 0; // 게임 종료 여부
 
     // 메인 게임 루프
-    while (!game_over && stage < MAX_STAGES) {
+    while (!game_over && !quit_signal && stage < MAX_STAGES) {
         // 키보드 입력이 있는지 확인
         if (kbhit()) {
             while(kbhit()) { // 버퍼 비우기
@@ -159,11 +360,16 @@ int main() {
         }
 
         update_game(c); // 입력에 따라 플레이어 이동/적이동/충돌 등 게임 상태 갱신
+        telemetry_tick(); // 현재 위치 카운트
         draw_game(); // 현재 상태를 화면에 다시 그리기
+        #ifdef MEM_TRACK
+            mem_steady = 1; // 첫 프레임 이후로는 힙 할당이 없어야 함
+        #endif
         delay(90); // 속도 조절
 
         // 'E' 즉 출구인 경우 스테이지 클리어
         if (map[stage][player_y][player_x] == 'E') {
+            telemetry_event(tel_CLEAR, player_x, player_y);
             stage++; // 다음 스테이지 이동
             score += 100; // 클리어 보너스 점수
             playsound(sound_CLEAR); // 클리어 사운드
@@ -178,28 +384,43 @@ int main() {
     }
 
     // 메인 루프 종료
+    #ifdef MEM_TRACK
+        mem_steady = 0;
+    #endif
     free_maps(); // 동적 할당된 맵 해제
     disable_raw_mode(); // 터미널 모드 복원
     show_cursor(); // 숨긴 커서 다시 표시
     return 0;
 }
 
+// 한 줄 읽기 : 버퍼보다 긴 줄은 나머지를 버려서 다음 줄로 넘어가지 않게 함
+char *read_line(char *buf, int size, FILE *file) {
+    if (!fgets(buf, size, file)) return NULL;
+    if (strchr(buf, '\n') == NULL) {
+        int ch;
+        while ((ch = fgetc(file)) != EOF && ch != '\n'); // 줄의 나머지 버리기
+    }
+    return buf;
+}
+
 // 맵 파일 로드
-void load_maps() {
-    FILE *file = fopen("map.txt", "r"); // 읽기 전용으로 map.txt 오픈
+void load_maps(const char *path) {
+    MemZone prev_zone = mem_enter(mem_LOADER);
+    FILE *file = fopen(path, "r"); // 읽기 전용으로 맵 파일 오픈
     if (!file) {
         // 파일 열기 실패시 에러 메세지 표시 후 프로그램 종료
-        perror("map.txt 파일을 열 수 없습니다.");
+        fprintf(stderr, "%s ", path);
+        perror("파일을 열 수 없습니다.");
         exit(1);
     }
     // 맵 크기, 스테이지 수 읽기
-    char buf[256]; // 한 줄을 읽을 버퍼
+    char buf[258]; // 한 줄을 읽을 버퍼 (제한 너비 256 + 개행 + NULL)
     int max_width = 0; // 최대 너비
     int max_height = 0; // 최대 높이
     int current_height = 0; // 현재 스테이지 높이
     int stage_count = 1; // 최소 1 스테이지 존재
 
-    while(fgets(buf, sizeof(buf), file)) {
+    while(read_line(buf, sizeof(buf), file)) {
         buf[strcspn(buf, "\r\n")] = 0; // 개행 문자 제거
 
         int len = strlen(buf); // 현재 줄 길이(length)
@@ -241,22 +462,31 @@ void load_maps() {
     map_width = max_width;
     map_height = max_height;
 
-    // 맵 동적 할당
-    map = (char ***)malloc(sizeof(char **) * MAX_STAGES); // 스테이지 포인터 동적 할당
+    // 맵 동적 할당 : 스테이지 포인터, y 포인터, 타일을 한 블록에 할당 (할당 1회)
+    size_t row_count = (size_t)MAX_STAGES * max_height; // 전체 줄 수
+    size_t row_size = max_width + 1; // NULL 문자용 +1
+    char *block = (char *)malloc(sizeof(char **) * MAX_STAGES + sizeof(char *) * row_count + row_size * row_count);
+    if (!block) {
+        fprintf(stderr, "맵을 불러올 메모리가 부족합니다.\n");
+        exit(1);
+    }
+    loaded_map = (char ***)block; // 스테이지 포인터
+    char **rows = (char **)(block + sizeof(char **) * MAX_STAGES); // y 포인터
+    char *tiles = (char *)(rows + row_count); // 타일 문자
+    memset(tiles, ' ', row_size * row_count); // 공백으로 초기화
     int i = 0;
     for(i = 0; i < MAX_STAGES; i++) {
-        map[i] = (char **)malloc(sizeof(char *) * max_height); // y 포인터 동적 할당
+        loaded_map[i] = rows + (size_t)i * max_height;
         for(int j = 0; j < max_height; j++) {
-            map[i][j] = (char *)malloc(sizeof(char) * max_width + 1); // x 포인터 동적 할당, NULL 문자용 +1
-            memset(map[i][j], ' ', max_width); // 공백으로 초기화
-            map[i][j][max_width] = '\0'; // 문자열 종료
+            loaded_map[i][j] = tiles + ((size_t)i * max_height + j) * row_size;
+            loaded_map[i][j][max_width] = '\0'; // 문자열 종료
         }
     }
 
     rewind(file); // 파일 포인터 처음으로 되돌리기
 
     int s = 0, y = 0; // s: 스테이지 인덱스, y: 현재 스테이지 높이
-    while(fgets(buf, sizeof(buf), file) && s < MAX_STAGES) { // 스테이지 수만큼 읽기
+    while(read_line(buf, sizeof(buf), file) && s < MAX_STAGES) { // 스테이지 수만큼 읽기
         buf[strcspn(buf, "\r\n")] = 0; // 개행 문자 제거
         int len = strlen(buf);
 
@@ -268,23 +498,63 @@ void load_maps() {
             continue;
         }
 
+        if(len > max_width) len = max_width; // 제한 너비를 넘는 부분은 버림 (문자열 종료 문자 보호)
         if(y < max_height) {
-            memcpy(map[s][y], buf, len); // 읽어온 줄 맵 메모리에 복사
+            memcpy(loaded_map[s][y], buf, len); // 읽어온 줄 맵 메모리에 복사
             y++; // 읽어온 길이만큼만 복사, 나머지는 공백 유지
         }
     }
     fclose(file); // 파일 닫기
-}       
+
+    map = (const char *const *const *)loaded_map; // 게임에서는 읽기 전용으로 사용
+    stage_table = NULL; // 오브젝트 위치는 init_stage에서 맵을 스캔해서 찾음
+    mem_leave(prev_zone);
+}
+
+// 빌드 시 내장된 맵 사용 : 파일 읽기, 파싱, 동적 할당 없이 읽기 전용 데이터를 그대로 사용
+void use_embedded_maps() {
+    #ifdef EMBED_MAPS
+        map = embedded_map;
+        stage_table = embedded_stages;
+        map_width = embedded_map_width;
+        map_height = embedded_map_height;
+        MAX_STAGES = embedded_stage_count;
+    #endif
+}
 
 
 // 현재 스테이지 초기화
 void init_stage() {
+    MemZone prev_zone = mem_enter(mem_STAGE);
     // 각종 상태 초기화
     enemy_count = 0;
     coin_count = 0;
     is_jumping = 0;
     velocity_y = 0;
 
+    // 다른 스테이지로 넘어온 경우 먹은 코인 기록 초기화
+    if (coin_stage != stage) {
+        memset(coin_taken, 0, sizeof(coin_taken));
+        coin_stage = stage;
+    }
+
+    // 내장 맵 : 미리 계산된 테이블에서 바로 가져옴 (맵 스캔과 같은 순서)
+    if (stage_table != NULL) {
+        const StageData *data = &stage_table[stage];
+        player_x = data->spawn.x;
+        player_y = data->spawn.y;
+        for (int i = 0; i < data->enemy_count && enemy_count < MAX_ENEMIES; i++) {
+            enemies[enemy_count] = (Enemy){data->enemies[i].x, data->enemies[i].y, (rand() % 2) * 2 - 1}; // 왼/오 방향 랜덤
+            enemy_count++;
+        }
+        for (int i = 0; i < data->coin_count && coin_count < MAX_COINS; i++) {
+            coins[coin_count] = (Coin){data->coins[i].x, data->coins[i].y, coin_taken[coin_count]};
+            coin_count++;
+        }
+        mem_leave(prev_zone);
+        return;
+    }
+
     // 현재 스테이지 전체를 돌며 오브젝트 위치 탐색
     for (int y = 0; y < map_height; y++) {
         for (int x = 0; x < map_width; x++) {
@@ -299,14 +569,17 @@ void init_stage() {
                 enemy_count++;
             } else if (cell == 'C' && coin_count < MAX_COINS) {
                 // 코인 'C' -> coins 배열에 추가
-                coins[coin_count++] = (Coin){x, y, 0};
+                coins[coin_count] = (Coin){x, y, coin_taken[coin_count]}; // 이미 먹은 코인은 먹은 상태 유지
+                coin_count++;
             }
         }
     }
+    mem_leave(prev_zone);
 }
 
 // 게임 화면 그리기
 void draw_game() {
+    MemZone prev_zone = mem_enter(mem_RENDER);
     #ifdef _WIN32
         gotoxy(1, 1); // 윈도우에서는 좌표만 이동
     #else
@@ -318,8 +591,11 @@ void draw_game() {
     for(int i=0; i<life; i++) printf("❤"); // 남은 생명만큼 하트 출력
     printf("\n조작: ← → (이동), ↑ ↓ (사다리), Space (점프), q (종료)\n");
 
-    // 표시용 맵 버퍼
-    char display_map[map_height][map_width + 1];
+    // 표시용 맵 버퍼 : 매 프레임 스택에 맵 크기 배열을 만들지 않도록 최대 크기로 한 번만 잡아둠
+    // 관전 방송 중이면 공유 메모리 슬롯에 바로 그려서 복사 없이 관전자에게 전달
+    static FrameRow display_buf[MAP_LIMIT];
+    FrameRow *display_map = broadcast_begin();
+    if (display_map == NULL) display_map = display_buf;
 
     for(int y=0; y < map_height; y++) {
         for(int x=0; x < map_width; x++) {
@@ -348,6 +624,7 @@ void draw_game() {
 
     // 플레이어 표시
     display_map[player_y][player_x] = 'P';
+    broadcast_end(); // 완성된 화면 공개
 
     // 완성된 맵 전체를 콘솔에 출력
     for (int y = 0; y < map_height; y++) {
@@ -356,6 +633,7 @@ void draw_game() {
         }
         printf("\n");
     }
+    mem_leave(prev_zone);
 }
 
 // 게임 상태 업데이트
@@ -370,8 +648,8 @@ void move_player(char input) {
     int before_x = player_x; // 이동 전 x위치 저장
     int next_x = player_x, next_y = player_y; // 이동 좌표
 
-    // 발밑 타일
-    char floor_tile = (player_y + 1 < map_height) ? map[stage][player_y + 1][player_x] : '#';
+    // 발밑 타일 : 맨 아래 줄 밑은 바닥이 없으므로 빈 칸 (떨어지면 맵 밖으로 나감)
+    char floor_tile = (player_y + 1 < map_height) ? map[stage][player_y + 1][player_x] : ' ';
     // 현재 타일
     char current_tile = map[stage][player_y][player_x];
     // 현재 위치가 사다리인지 여부
@@ -429,10 +707,14 @@ void move_player(char input) {
             for(int i = 0; i < step; i++) {
                 int ch_y = player_y + mov; // 1칸 이동했을때 위치 확인
 
-                // 천장, 바닥 충돌 체크
-                if(ch_y < 0 || ch_y >= map_height) {
+                // 천장 충돌 체크
+                if(ch_y < 0) {
                     velocity_y = 0; // 속도 멈춤
-                    if(ch_y < 0) ch_y = 0; // 천장 뚫고 나가는것 금지
+                    break;
+                }
+                // 맵 아래로 벗어남 -> 아래의 낙하 처리로 넘김
+                if(ch_y >= map_height) {
+                    player_y = ch_y;
                     break;
                 }
 
@@ -462,7 +744,10 @@ void move_player(char input) {
     }
     
     // 맵 아래로 떨어진 경우 스테이지를 다시 초기화
-    if (player_y >= map_height) init_stage();
+    if (player_y >= map_height) {
+        telemetry_event(tel_FALL, player_x, map_height - 1); // 떨어진 열 기록
+        init_stage();
+    }
 
     // 벽 끼임 확인 -> x,y 되돌리기
     if (player_x >= 0 && player_x < map_width && 
@@ -489,6 +774,7 @@ void move_enemies() {
 void check_collisions() {
     for (int i = 0; i < enemy_count; i++) {
         if (player_x == enemies[i].x && player_y == enemies[i].y) {
+            telemetry_event(tel_DEATH, player_x, player_y);
             life--; // 목숨 1 감소
             playsound(sound_ENEMY); // 적 충돌 사운드
             clrscr(); // 하트 개수 갱신을 위해 화면 클리어
@@ -503,8 +789,9 @@ void check_collisions() {
     for (int i = 0; i < coin_count; i++) {
         if (!coins[i].collected && player_x == coins[i].x && player_y == coins[i].y) {
             coins[i].collected = 1; // 코인상태 -> 먹은것으로 표시
-            map[stage][player_y][player_x] = ' '; // map 배열에서 코인 제거
+            coin_taken[i] = 1; // 재시작해도 다시 나타나지 않도록 기록
             score += 20; // 점수 증가
+            telemetry_event(tel_COIN, player_x, player_y);
             playsound(sound_COIN); // 코인 사운드
         }
     }
@@ -516,6 +803,13 @@ void check_collisions() {
     void disable_raw_mode() {}
     void enable_raw_mode() {} 
 
+    // 관전 방송은 POSIX 공유 메모리를 사용하므로 Windows에서는 지원하지 않음
+    void broadcast_open() {}
+    void broadcast_close() {}
+    FrameRow *broadcast_begin() { return NULL; }
+    void broadcast_end() {}
+    void spectate(int pid) { (void)pid; printf("관전 모드는 Linux/macOS에서만 지원합니다.\n"); }
+
     // 콘솔 커서 이동 함수
     void gotoxy(int x, int y) {
         // COORD는 0기반 -> x-1, y-1
@@ -528,6 +822,7 @@ void check_collisions() {
 
     // 사운드 : Beep(주파수, 지속시간ms)를 이용
     void playsound(Play type) {
+        MemZone prev_zone = mem_enter(mem_AUDIO);
         switch(type) {
             case sound_COIN:
                 Beep(1800,50);
@@ -550,6 +845,7 @@ void check_collisions() {
                 Beep(500,500);
                 break;
         }
+        mem_leave(prev_zone);
     }
 
 #else // Linux + macOS
@@ -565,6 +861,235 @@ void check_collisions() {
         tcsetattr(STDIN_FILENO, TCSAFLUSH, &raw);
     }
 
+    // 프로세스가 살아 있는지 (권한이 없어 신호를 못 보내는 경우도 살아 있는 것)
+    int process_alive(int pid) {
+        return pid > 0 && (kill(pid, 0) == 0 || errno == EPERM);
+    }
+
+    // 방송한 게임이 아직 실행 중인지 : 헤더의 PID로 확인 (확인할 수 없으면 실행 중으로 봄)
+    int broadcast_live(const char *name) {
+        int fd = shm_open(name, O_RDONLY, 0);
+        if (fd < 0) return 0;
+        struct stat st;
+        int live = 1;
+        if (fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(BroadcastHeader)) {
+            const BroadcastHeader *header = (const BroadcastHeader *)mmap(NULL, sizeof(BroadcastHeader), PROT_READ, MAP_SHARED, fd, 0);
+            if (header != MAP_FAILED) {
+                if (atomic_load_explicit(&header->magic, memory_order_acquire) == BROADCAST_MAGIC) {
+                    live = atomic_load(&header->alive) && process_alive(header->pid);
+                }
+                munmap((void *)header, sizeof(BroadcastHeader));
+            }
+        }
+        close(fd);
+        return live;
+    }
+
+    // 관전 방송 시작 : 이 게임 전용 공유 메모리를 새로 만들고 맵 크기 기록
+    void broadcast_open() {
+        int slot_size = (int)(sizeof(BroadcastSlot) + sizeof(FrameRow) * map_height);
+        slot_size = (slot_size + 63) / 64 * 64; // 슬롯끼리 캐시 라인을 나눠 쓰지 않도록 정렬
+        size_t size = BROADCAST_HEADER_SIZE + (size_t)slot_size * BROADCAST_SLOTS;
+
+        snprintf(broadcast_name, sizeof(broadcast_name), BROADCAST_PREFIX "%d", (int)getpid());
+        int fd = shm_open(broadcast_name, O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (fd < 0 && errno == EEXIST && !broadcast_live(broadcast_name)) {
+            // 같은 PID를 쓰던 게임이 비정상 종료로 남긴 방송 : 실행 중이 아님을 확인했으므로 지우고 다시 만듦
+            shm_unlink(broadcast_name);
+            fd = shm_open(broadcast_name, O_CREAT | O_EXCL | O_RDWR, 0644);
+        }
+        if (fd < 0) return; // 만들지 못했으면 방송 없이 진행 (남의 방송은 건드리지 않음)
+        if (ftruncate(fd, size) != 0) {
+            close(fd);
+            shm_unlink(broadcast_name); // 방금 이 프로세스가 만든 것만 제거
+            return;
+        }
+        void *mem = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd); // 매핑 후에는 fd 불필요
+        if (mem == MAP_FAILED) {
+            shm_unlink(broadcast_name);
+            return;
+        }
+
+        broadcast = (BroadcastHeader *)mem;
+        broadcast_size = size;
+        broadcast->pid = (int)getpid();
+        broadcast->width = map_width;
+        broadcast->height = map_height;
+        broadcast->slot_count = BROADCAST_SLOTS;
+        broadcast->slot_size = slot_size;
+        atomic_store(&broadcast->latest, 0);
+        atomic_store(&broadcast->alive, 1);
+        atomic_store_explicit(&broadcast->magic, BROADCAST_MAGIC, memory_order_release); // 관전자는 이 값을 확인 후 읽음
+        atexit(broadcast_close); // 종료 시 자동으로 방송 종료
+    }
+
+    // 슬롯 주소 : 헤더 영역 뒤로 슬롯이 이어짐
+    BroadcastSlot *broadcast_slot_at(const BroadcastHeader *header, unsigned index) {
+        return (BroadcastSlot *)((char *)header + BROADCAST_HEADER_SIZE + (size_t)header->slot_size * index);
+    }
+
+    // 방송 종료 : 관전자에게 종료를 알리고 이 프로세스가 만든 공유 메모리 제거
+    void broadcast_close() {
+        if (broadcast == NULL) return;
+        atomic_store(&broadcast->alive, 0);
+        munmap(broadcast, broadcast_size);
+        broadcast = NULL;
+        shm_unlink(broadcast_name);
+    }
+
+    // 다음 슬롯에 쓰기 시작 : seq를 홀수로 만들어 관전자가 읽지 않게 함
+    FrameRow *broadcast_begin() {
+        if (broadcast == NULL) return NULL;
+        broadcast_slot = (atomic_load_explicit(&broadcast->latest, memory_order_relaxed) + 1) % BROADCAST_SLOTS;
+        BroadcastSlot *slot = broadcast_slot_at(broadcast, broadcast_slot);
+        unsigned seq = atomic_load_explicit(&slot->seq, memory_order_relaxed);
+        atomic_store_explicit(&slot->seq, seq + 1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release); // seq 변경이 화면 쓰기보다 먼저 보이도록
+        return slot->rows;
+    }
+
+    // 쓰기 완료 : HUD 기록 후 seq를 짝수로 되돌리고 최신 슬롯으로 공개
+    void broadcast_end() {
+        if (broadcast == NULL) return;
+        BroadcastSlot *slot = broadcast_slot_at(broadcast, broadcast_slot);
+        slot->stage = stage;
+        slot->score = score;
+        slot->life = life;
+        unsigned seq = atomic_load_explicit(&slot->seq, memory_order_relaxed);
+        atomic_store_explicit(&slot->seq, seq + 1, memory_order_release);
+        atomic_store_explicit(&broadcast->latest, broadcast_slot, memory_order_release);
+    }
+
+    // 실행 중인 게임의 방송 찾기 : 하나면 그 PID, 없으면 0, 여럿이면 목록을 출력하고 -1
+    // 공유 메모리 목록은 Linux의 /dev/shm에서만 볼 수 있으므로 그 밖에서는 PID를 직접 지정해야 함
+    int broadcast_find() {
+        DIR *dir = opendir("/dev/shm");
+        if (dir == NULL) return 0;
+        char name[300];
+        int found = 0, count = 0;
+        struct dirent *entry;
+        while ((entry = readdir(dir)) != NULL) {
+            if (strncmp(entry->d_name, BROADCAST_PREFIX + 1, strlen(BROADCAST_PREFIX) - 1) != 0) continue;
+            int pid = atoi(entry->d_name + strlen(BROADCAST_PREFIX) - 1);
+            snprintf(name, sizeof(name), "/%s", entry->d_name);
+            if (pid <= 0) continue;
+            if (!broadcast_live(name)) { // 비정상 종료로 남은 방송 : 쌓이지 않도록 지우고 건너뜀
+                shm_unlink(name);
+                continue;
+            }
+            if (count == 1) printf("실행 중인 게임이 여러 개입니다. --spectate <PID>로 골라 주세요.\n  PID %d\n", found);
+            if (count >= 1) printf("  PID %d\n", pid);
+            found = pid;
+            count++;
+        }
+        closedir(dir);
+        return (count > 1) ? -1 : found;
+    }
+
+    // 관전 모드 : 공유 메모리를 읽기 전용으로 열어 최신 화면을 표시 (게임에는 영향 없음)
+    // pid가 0이면 실행 중인 게임을 찾아서 관전
+    void spectate(int pid) {
+        if (pid == 0) pid = broadcast_find();
+        if (pid < 0) return; // 여러 게임 중 고르지 않음
+        if (pid == 0) {
+            printf("실행 중인 게임이 없습니다. (게임의 PID를 --spectate <PID>로 지정할 수 있습니다)\n");
+            return;
+        }
+        char name[32];
+        snprintf(name, sizeof(name), BROADCAST_PREFIX "%d", pid);
+        int fd = shm_open(name, O_RDONLY, 0);
+        if (fd < 0) {
+            printf("PID %d 게임의 방송이 없습니다.\n", pid);
+            return;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || (size_t)st.st_size < BROADCAST_HEADER_SIZE) {
+            close(fd);
+            printf("방송 정보를 읽을 수 없습니다.\n");
+            return;
+        }
+        const BroadcastHeader *header = (const BroadcastHeader *)mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (header == MAP_FAILED) {
+            printf("방송 정보를 읽을 수 없습니다.\n");
+            return;
+        }
+        // 헤더 검증 : 한 번 읽어 둔 값으로 슬롯이 매핑 범위 안에 들어오는지 확인하고 이후에는 이 값만 사용
+        int valid = atomic_load_explicit(&header->magic, memory_order_acquire) == BROADCAST_MAGIC;
+        int width = header->width, height = header->height;
+        int slot_count = header->slot_count, slot_size = header->slot_size;
+        valid = valid && width > 0 && width <= MAP_LIMIT && height > 0 && height <= MAP_LIMIT
+                && slot_count == BROADCAST_SLOTS && slot_size > 0
+                && (size_t)slot_size >= sizeof(BroadcastSlot) + sizeof(FrameRow) * height
+                && (size_t)st.st_size >= BROADCAST_HEADER_SIZE + (size_t)slot_size * slot_count;
+        if (!valid) {
+            munmap((void *)header, st.st_size);
+            printf("방송 정보가 올바르지 않습니다.\n");
+            return;
+        }
+
+        static FrameRow view[MAP_LIMIT]; // 읽어온 화면 복사본
+        int view_stage = 0, view_score = 0, view_life = 0;
+        unsigned shown_index = 0, shown_seq = 0; // 마지막으로 표시한 슬롯 번호와 seq
+
+        int game_pid = header->pid;
+        int game_lost = 0; // 1: 게임이 alive를 내리지 못하고 종료됨 (Ctrl-C, 비정상 종료)
+        time_t last_check = time(NULL);
+
+        clrscr();
+        hide_cursor();
+        enable_raw_mode();
+        while (atomic_load(&header->alive) && !quit_signal) {
+            if (kbhit() && getch() == 'q') break; // q 입력 시 관전 종료
+            if (time(NULL) != last_check) { // 1초마다 게임 프로세스 확인
+                last_check = time(NULL);
+                if (!process_alive(game_pid)) {
+                    game_lost = 1;
+                    break;
+                }
+            }
+
+            // 최신 슬롯 읽기 : 읽는 중에 게임이 덮어쓰면 (seq 변경) 다시 읽음
+            unsigned index = atomic_load_explicit(&header->latest, memory_order_acquire);
+            if (index >= (unsigned)slot_count) { // 잘못된 슬롯 번호
+                delay(10);
+                continue;
+            }
+            const BroadcastSlot *slot = (const BroadcastSlot *)((const char *)header + BROADCAST_HEADER_SIZE + (size_t)slot_size * index);
+            unsigned seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+            if (seq == 0 || (seq & 1) || (index == shown_index && seq == shown_seq)) { // 아직 없음, 쓰는 중, 이미 표시한 화면
+                delay(10);
+                continue;
+            }
+            memcpy(view, slot->rows, sizeof(FrameRow) * height);
+            view_stage = slot->stage;
+            view_score = slot->score;
+            view_life = slot->life;
+            atomic_thread_fence(memory_order_acquire);
+            if (atomic_load_explicit(&slot->seq, memory_order_relaxed) != seq) continue;
+            shown_index = index;
+            shown_seq = seq;
+
+            // 게임 화면과 같은 형식으로 출력
+            gotoxy(1, 1);
+            printf("[관전] Stage: %d | Score: %d\n", view_stage + 1, view_score);
+            printf("Life :%d ", view_life);
+            for (int i = 0; i < view_life; i++) printf("❤");
+            printf("\033[K\nq (관전 종료)\n");
+            for (int y = 0; y < height; y++) {
+                fwrite(view[y], 1, width, stdout);
+                putchar('\n');
+            }
+            fflush(stdout);
+        }
+
+        if (game_lost || !atomic_load(&header->alive)) printf("\n게임이 종료되어 관전을 마칩니다.\n");
+        munmap((void *)header, st.st_size);
+        disable_raw_mode();
+        show_cursor();
+    }
+
     // 커서 이동
     void gotoxy(int x, int y) {
         printf("\033[%d;%dH",y,x);
@@ -618,6 +1143,7 @@ void check_collisions() {
     #if defined(__APPLE__)
         // macOS에서는 afplay 명령어 사용
         void playsound(Play type) {
+            MemZone prev_zone = mem_enter(mem_AUDIO);
             // system 함수에서 &으로 백그라운드에서 실행
             // > /dev/null 2>&1 불필요한 터미널 출력을 숨김
             switch (type) {
@@ -636,11 +1162,13 @@ void check_collisions() {
                 default:
                     printf("\a");
                     break;
+            }
+            mem_leave(prev_zone);
         }
-    }
     #else
         // '\a' (벨) 사운드 이용
         void playsound(Play type) {
+            MemZone prev_zone = mem_enter(mem_AUDIO);
             switch (type) {
                 case sound_COIN:
                     printf("\a");
@@ -669,6 +1197,7 @@ void check_collisions() {
                     break;
             }
             fflush(stdout);
+            mem_leave(prev_zone);
         }
     #endif
 #endif // 플랫폼 분기 끝
@@ -686,16 +1215,11 @@ void show_cursor() {
 }
 
 void free_maps() { // 맵 메모리 해제
-    if(map == NULL) return;
+    map = NULL; // 내장 맵은 읽기 전용이라 해제할 필요 없음
+    if(loaded_map == NULL) return;
 
-    for(int s = 0; s < MAX_STAGES; s++) { // 2중 for문으로 3차원 배열 해제
-        for(int y = 0; y < map_height; y++) {
-            free(map[s][y]); // x 포인터 해제
-        }
-        free(map[s]); // y 포인터 해제
-    }
-    free(map); // 스테이지 포인터 해제
-    map = NULL; // 포인터 초기화
+    free(loaded_map); // 한 블록으로 할당했으므로 한 번에 해제
+    loaded_map = NULL; // 포인터 초기화
 }
 
 // 타이틀 시작 화면
@@ -726,7 +1250,7 @@ void title() {
         show_cursor();
         exit(0);
     }
-    else return; // main에서 init_stage 후 게임 시작
+    else return; // main에서 init_stage 후 게임 시작 (종료 신호를 받았으면 게임 루프를 건너뛰고 종료)
 }
 
 // 게임 오버 화면
@@ -748,16 +1272,14 @@ void game_over() {
 		stage = 0;
 		score = 0;
 		life = 3;
-
-        free_maps(); // 먹은 코인 초기화를 위해 맵 메모리 해제
-		load_maps(); // 맵 다시 로드
+		coin_stage = -1; // 먹은 코인 기록 초기화 (맵은 수정되지 않으므로 다시 읽을 필요 없음)
 
 		init_stage(); // 스테이지 초기화
 		return; // main의 게임루프로 복귀
 	}
 
-    // q 입력 시 완전 종료
-	if(key == 'q' || key == 'Q'){
+    // q 입력 또는 종료 신호 시 완전 종료
+	if(key == 'q' || key == 'Q' || quit_signal){
 		clrscr();
         free_maps();
 		disable_raw_mode();
@@ -794,3 +1316,326 @@ void ending() {
     show_cursor();
     exit(0);
 }
+
+// 종료 신호 처리 : 표시만 하고 돌아감 (두 번째 신호는 기본 동작으로 즉시 종료)
+void quit_handler(int sig) {
+    (void)sig;
+    quit_signal = 1;
+}
+
+void catch_quit_signals() {
+    #ifdef _WIN32
+        signal(SIGINT, quit_handler);
+        signal(SIGTERM, quit_handler);
+    #else
+        // SA_RESTART 없이 등록해서 getch()의 입력 대기가 신호로 깨어나게 함
+        struct sigaction sa;
+        memset(&sa, 0, sizeof(sa));
+        sa.sa_handler = quit_handler;
+        sa.sa_flags = SA_RESETHAND;
+        sigemptyset(&sa.sa_mask);
+        sigaction(SIGINT, &sa, NULL);
+        sigaction(SIGTERM, &sa, NULL);
+        sigaction(SIGHUP, &sa, NULL);
+    #endif
+}
+
+// 쓰기 스레드 : 링 버퍼에 쌓인 이벤트를 한 번에 파일에 기록
+void telemetry_flush() {
+    unsigned head = atomic_load_explicit(&telemetry_head, memory_order_acquire);
+    unsigned tail = atomic_load_explicit(&telemetry_tail, memory_order_relaxed);
+    if (head == tail) return;
+    while (tail != head) {
+        unsigned start = tail % TELEMETRY_RING;
+        unsigned n = head - tail;
+        if (start + n > TELEMETRY_RING) n = TELEMETRY_RING - start; // 링 끝까지만 쓰고 나머지는 다음 반복
+        fwrite(&telemetry_ring[start], sizeof(TelemetryRecord), n, telemetry_file);
+        tail += n;
+    }
+    atomic_store_explicit(&telemetry_tail, tail, memory_order_release); // 비운 자리를 게임에 돌려줌
+    fflush(telemetry_file);
+}
+
+#ifdef _WIN32
+    DWORD WINAPI telemetry_main(LPVOID arg) {
+#else
+    void *telemetry_main(void *arg) {
+#endif
+    (void)arg;
+    while (atomic_load(&telemetry_running)) {
+        telemetry_flush();
+        delay(TELEMETRY_FLUSH_MS);
+    }
+    return 0;
+}
+
+// 게임 기록 시작 : 파일 끝에 세션 시작 기록을 쓰고 쓰기 스레드 실행
+void telemetry_open(const char *path) {
+    if (MAX_STAGES > 65535) { // 기록 형식의 스테이지 번호는 16비트
+        fprintf(stderr, "스테이지가 너무 많아 게임 기록을 하지 않습니다.\n");
+        return;
+    }
+    telemetry_file = fopen(path, "ab"); // 이어 쓰기 전용
+    if (!telemetry_file) {
+        fprintf(stderr, "%s ", path);
+        perror("기록 파일을 열 수 없습니다.");
+        return;
+    }
+    setvbuf(telemetry_file, telemetry_file_buf, _IOFBF, sizeof(telemetry_file_buf));
+    heatmap = (uint32_t *)calloc((size_t)MAX_STAGES * map_height * map_width, sizeof(uint32_t));
+    if (!heatmap) {
+        fclose(telemetry_file);
+        telemetry_file = NULL;
+        fprintf(stderr, "게임 기록용 메모리가 부족합니다.\n");
+        return;
+    }
+
+    TelemetryRecord session = {TELEMETRY_MAGIC, tel_SESSION, (uint16_t)MAX_STAGES, (uint16_t)map_width, (uint16_t)map_height};
+    fwrite(&session, sizeof(session), 1, telemetry_file);
+
+    atomic_store(&telemetry_running, 1);
+    #ifdef _WIN32
+        telemetry_thread = CreateThread(NULL, 0, telemetry_main, NULL, 0, NULL);
+        int started = (telemetry_thread != NULL);
+    #else
+        // 쓰기 스레드는 종료 신호를 막아 두어 신호가 메인 스레드로 가서 입력 대기를 깨우도록 함
+        sigset_t block, old;
+        sigemptyset(&block);
+        sigaddset(&block, SIGINT);
+        sigaddset(&block, SIGTERM);
+        sigaddset(&block, SIGHUP);
+        pthread_sigmask(SIG_BLOCK, &block, &old);
+        int started = (pthread_create(&telemetry_thread, NULL, telemetry_main, NULL) == 0);
+        pthread_sigmask(SIG_SETMASK, &old, NULL);
+    #endif
+    if (!started) {
+        fclose(telemetry_file);
+        telemetry_file = NULL;
+        free(heatmap);
+        heatmap = NULL;
+        return;
+    }
+    telemetry_on = 1;
+    atexit(telemetry_close); // 종료 시 남은 기록과 위치 카운터 저장
+}
+
+// 게임 기록 종료 : 쓰기 스레드를 멈추고 남은 이벤트와 스테이지별 위치 카운터 기록
+void telemetry_close() {
+    if (!telemetry_on) return;
+    telemetry_on = 0;
+    atomic_store(&telemetry_running, 0);
+    #ifdef _WIN32
+        WaitForSingleObject(telemetry_thread, INFINITE);
+        CloseHandle(telemetry_thread);
+    #else
+        pthread_join(telemetry_thread, NULL);
+    #endif
+    telemetry_flush();
+
+    size_t cells = (size_t)map_height * map_width;
+    for (int s = 0; s < MAX_STAGES; s++) {
+        TelemetryRecord record = {(uint32_t)game_tick, tel_HEATMAP, (uint16_t)s, (uint16_t)map_width, (uint16_t)map_height};
+        fwrite(&record, sizeof(record), 1, telemetry_file);
+        fwrite(heatmap + s * cells, sizeof(uint32_t), cells, telemetry_file);
+    }
+    if (telemetry_dropped > 0) fprintf(stderr, "게임 기록: 버퍼가 가득 차서 이벤트 %lu개를 버렸습니다.\n", telemetry_dropped);
+    fclose(telemetry_file);
+    telemetry_file = NULL;
+    free(heatmap);
+    heatmap = NULL;
+}
+
+// 틱마다 현재 위치 카운트
+void telemetry_tick() {
+    game_tick++;
+    if (!telemetry_on) return;
+    if (player_x < 0 || player_x >= map_width || player_y < 0 || player_y >= map_height) return;
+    heatmap[((size_t)stage * map_height + player_y) * map_width + player_x]++;
+}
+
+// 이벤트를 링 버퍼에 넣음 : 가득 차 있으면 기다리지 않고 버림
+void telemetry_event(TelemetryType type, int x, int y) {
+    if (!telemetry_on) return;
+    unsigned head = atomic_load_explicit(&telemetry_head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&telemetry_tail, memory_order_acquire);
+    if (head - tail >= TELEMETRY_RING) {
+        telemetry_dropped++;
+        return;
+    }
+    telemetry_ring[head % TELEMETRY_RING] = (TelemetryRecord){(uint32_t)game_tick, (uint16_t)type, (uint16_t)stage, (uint16_t)x, (uint16_t)y};
+    atomic_store_explicit(&telemetry_head, head + 1, memory_order_release); // 쓰기 스레드에 공개
+}
+
+#ifdef MEM_TRACK
+    // glibc 내부 할당 함수 : 아래에서 malloc 등을 가로챈 뒤 실제 할당은 여기로 넘김
+    extern void *__libc_malloc(size_t size);
+    extern void *__libc_calloc(size_t n, size_t size);
+    extern void *__libc_realloc(void *ptr, size_t size);
+    extern void *__libc_memalign(size_t align, size_t size);
+    extern void __libc_free(void *ptr);
+
+    const char *mem_zone_names[mem_ZONE_COUNT] = {"main", "loader", "stage", "render", "audio"};
+
+    // 현재 스택 아래를 무늬로 칠함 : 지역 배열로 스택을 실제로 잡은 뒤 채우므로 스택 포인터 아래를 건드리지 않음
+    __attribute__((noinline)) void mem_paint_stack() {
+        volatile uint64_t area[STACK_PAINT_SIZE / sizeof(uint64_t)];
+        for (size_t i = 0; i < STACK_PAINT_SIZE / sizeof(uint64_t); i++) area[i] = STACK_PAINT;
+        stack_paint_low = (uintptr_t)area; // 함수가 끝난 뒤에 읽으므로 주소 값으로 보관
+        stack_paint_high = stack_paint_low + STACK_PAINT_SIZE;
+    }
+
+    // 마지막으로 칠한 뒤 쓰인 가장 깊은 스택 위치를 구역 통계에 반영
+    void mem_scan_stack(MemZone zone) {
+        if (stack_base == NULL || stack_paint_low == 0) return;
+        const volatile uint64_t *p = (const volatile uint64_t *)stack_paint_low;
+        while ((uintptr_t)p < stack_paint_high && *p == STACK_PAINT) p++; // 깊은 쪽부터 무늬가 남은 곳 건너뛰기
+        size_t depth = (size_t)(stack_base - (const char *)p);
+        if (depth > mem_stats[zone].stack_peak) mem_stats[zone].stack_peak = depth;
+    }
+
+    // 구역 진입 : 이전 구역을 돌려주므로 끝날 때 mem_leave로 복원 (메인 스레드에서만 호출)
+    // 이전 구역의 깊이를 먼저 반영한 뒤 다시 칠하므로 이후 깊이는 새 구역의 것
+    MemZone mem_enter(MemZone zone) {
+        MemZone prev = mem_zone;
+        mem_scan_stack(prev);
+        mem_paint_stack();
+        mem_zone = zone;
+        return prev;
+    }
+
+    // 구역 종료 : 다시 칠하지 않으므로 이 구역의 깊이는 바깥 구역에도 반영됨
+    void mem_leave(MemZone prev) {
+        mem_scan_stack(mem_zone);
+        mem_zone = prev;
+    }
+
+    // 종료 시 통계 출력
+    void mem_report() {
+        mem_steady = 0; // 출력 중 할당은 검사하지 않음
+        mem_scan_stack(mem_zone);
+        fprintf(stderr, "\n[메모리] 구역      할당    해제        바이트    사용 중    최대 힙   최대 스택\n");
+        for (int i = 0; i < mem_ZONE_COUNT; i++) {
+            MemStat *st = &mem_stats[i];
+            fprintf(stderr, "[메모리] %-8s %6lu  %6lu  %12zu  %9zu  %9zu  %10zu\n",
+                    mem_zone_names[i], st->allocs, st->frees, st->bytes, st->live, st->heap_peak, st->stack_peak);
+        }
+        fprintf(stderr, "[메모리] 최대 힙 %zu 바이트, 종료 시 사용 중 %zu 바이트, 메인 루프 중 할당 %lu회\n",
+                heap_peak, heap_in_use, steady_allocs);
+        if (mem_untracked > 0) fprintf(stderr, "[메모리] 블록 표가 가득 차 구역을 기록하지 못한 할당 %lu회\n", mem_untracked);
+    }
+
+    // 블록 표 위치 (포인터 해시)
+    size_t mem_slot(void *ptr) {
+        return (size_t)(((uintptr_t)ptr >> 4) * 0x9E3779B97F4A7C15ULL >> 16) & (MEM_TABLE_SIZE - 1);
+    }
+
+    void mem_lock_acquire() {
+        while (atomic_flag_test_and_set_explicit(&mem_lock, memory_order_acquire));
+    }
+
+    void mem_lock_release() {
+        atomic_flag_clear_explicit(&mem_lock, memory_order_release);
+    }
+
+    // 할당 기록 : 블록을 현재 구역에 달아 두고, 메인 루프 중 할당이면 기록하고 MEM_ASSERT면 즉시 중단
+    void mem_count_alloc(void *ptr) {
+        if (ptr == NULL) return;
+        size_t size = malloc_usable_size(ptr);
+        MemZone zone = mem_zone;
+        mem_lock_acquire();
+        MemStat *st = &mem_stats[zone];
+        st->allocs++;
+        st->bytes += size;
+        size_t i = mem_slot(ptr), n = 0;
+        while (mem_blocks[i].ptr != NULL && n < MEM_TABLE_SIZE) {
+            i = (i + 1) & (MEM_TABLE_SIZE - 1);
+            n++;
+        }
+        if (n < MEM_TABLE_SIZE) { // 표에 기록한 블록만 사용량에 넣음 (해제 시 뺄 수 있도록)
+            mem_blocks[i] = (MemBlock){ptr, size, zone};
+            st->live += size;
+            if (st->live > st->heap_peak) st->heap_peak = st->live;
+            heap_in_use += size;
+            if (heap_in_use > heap_peak) heap_peak = heap_in_use;
+        } else {
+            mem_untracked++;
+        }
+        mem_lock_release();
+        if (mem_steady) {
+            steady_allocs++;
+            #ifdef MEM_ASSERT
+                mem_steady = 0;
+                fprintf(stderr, "\n[메모리] 메인 루프 중 힙 할당 발생 (구역: %s, %zu 바이트)\n", mem_zone_names[zone], size);
+                mem_report();
+                disable_raw_mode();
+                abort();
+            #endif
+        }
+    }
+
+    // 해제 기록 : 블록을 할당한 구역의 사용량을 줄이고 표에서 뺌 (표에 없는 블록은 무시)
+    // 빈 칸이 생기면 뒤따르는 블록을 당겨 채워서 탐색이 끊기지 않게 함
+    void mem_count_free(void *ptr) {
+        if (ptr == NULL) return;
+        mem_lock_acquire();
+        size_t i = mem_slot(ptr), n = 0;
+        while (mem_blocks[i].ptr != ptr && mem_blocks[i].ptr != NULL && n < MEM_TABLE_SIZE) {
+            i = (i + 1) & (MEM_TABLE_SIZE - 1);
+            n++;
+        }
+        if (mem_blocks[i].ptr == ptr) {
+            MemStat *st = &mem_stats[mem_blocks[i].zone];
+            st->frees++;
+            st->live -= mem_blocks[i].size;
+            heap_in_use -= mem_blocks[i].size;
+            size_t hole = i;
+            for (size_t j = (i + 1) & (MEM_TABLE_SIZE - 1); mem_blocks[j].ptr != NULL; j = (j + 1) & (MEM_TABLE_SIZE - 1)) {
+                size_t home = mem_slot(mem_blocks[j].ptr);
+                // home이 (hole, j] 범위 밖이면 hole로 당겨도 탐색 경로가 유지됨
+                if (((j - home) & (MEM_TABLE_SIZE - 1)) >= ((j - hole) & (MEM_TABLE_SIZE - 1))) {
+                    mem_blocks[hole] = mem_blocks[j];
+                    hole = j;
+                }
+            }
+            mem_blocks[hole].ptr = NULL;
+        }
+        mem_lock_release();
+    }
+
+    // 표준 할당 함수 가로채기 (libc 내부 할당도 포함해서 셈)
+    void *malloc(size_t size) {
+        void *ptr = __libc_malloc(size);
+        mem_count_alloc(ptr);
+        return ptr;
+    }
+    void *calloc(size_t n, size_t size) {
+        void *ptr = __libc_calloc(n, size);
+        mem_count_alloc(ptr);
+        return ptr;
+    }
+    void *realloc(void *ptr, size_t size) {
+        void *new_ptr = __libc_realloc(ptr, size);
+        if (new_ptr == NULL && size > 0) return NULL; // 실패 시 원래 블록이 그대로 남음
+        mem_count_free(ptr); // 옮겨졌거나 크기가 바뀐 블록은 해제 후 현재 구역의 새 할당으로 기록
+        mem_count_alloc(new_ptr);
+        return new_ptr;
+    }
+    void *memalign(size_t align, size_t size) {
+        void *ptr = __libc_memalign(align, size);
+        mem_count_alloc(ptr);
+        return ptr;
+    }
+    void *aligned_alloc(size_t align, size_t size) {
+        return memalign(align, size);
+    }
+    int posix_memalign(void **out, size_t align, size_t size) {
+        void *ptr = memalign(align, size);
+        if (ptr == NULL) return 12; // ENOMEM
+        *out = ptr;
+        return 0;
+    }
+    void free(void *ptr) {
+        mem_count_free(ptr);
+        __libc_free(ptr);
+    }
+#endif
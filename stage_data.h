@@ -0,0 +1,27 @@
+// 빌드 시 내장되는 스테이지 데이터 정의
+// tools/map2c.c 가 map.txt를 읽어 이 형식의 C 소스(map_data.c)를 생성한다.
+#ifndef STAGE_DATA_H
+#define STAGE_DATA_H
+
+// 맵 좌표
+typedef struct {
+    int x, y;
+} StagePoint;
+
+// 미리 계산된 스테이지 오브젝트 정보
+typedef struct {
+    StagePoint spawn; // 시작 위치 'S'
+    const StagePoint *enemies; // 적 'X' 위치 목록 (맵 스캔 순서)
+    int enemy_count; // 적 개수
+    const StagePoint *coins; // 코인 'C' 위치 목록 (맵 스캔 순서)
+    int coin_count; // 코인 개수
+} StageData;
+
+// map_data.c 에 정의되는 읽기 전용 데이터
+extern const int embedded_map_width; // 맵 가로 길이
+extern const int embedded_map_height; // 맵 세로 길이
+extern const int embedded_stage_count; // 스테이지 개수
+extern const char *const *const embedded_map[]; // [stage][y] -> 공백으로 채워진 한 줄 문자열
+extern const StageData embedded_stages[]; // 스테이지별 오브젝트 테이블
+
+#endif // STAGE_DATA_H
@@ -0,0 +1,35 @@
+// 게임 기록(텔레메트리) 파일 형식
+// nuguri.c가 --telemetry로 기록하고 tools/tlmagg.c가 여러 파일을 합쳐서 분석한다.
+//
+// 파일은 12바이트 기록(TelemetryRecord)의 연속이며 기록한 컴퓨터의 바이트 순서를 따른다.
+// 파일 끝에 이어 쓰기만 하므로 한 파일에 여러 세션이 이어 붙을 수 있다.
+//   tel_SESSION : 세션 시작. tick = TELEMETRY_MAGIC, x/y = 맵 너비/높이, stage = 스테이지 수
+//   tel_DEATH, tel_FALL, tel_COIN, tel_CLEAR : tick 시점에 stage의 (x, y)에서 일어난 이벤트
+//   tel_HEATMAP : 세션 종료 시 스테이지별 위치 카운터. tick = 세션 전체 틱 수, x/y = 맵 너비/높이
+//                 기록 바로 뒤에 uint32_t 카운터 x*y개가 (y, x) 순서로 이어짐
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+
+#define TELEMETRY_MAGIC 0x4C54474EU // "NGTL"
+
+// 기록 종류
+typedef enum {
+    tel_SESSION = 1, // 세션 시작
+    tel_DEATH, // 적과 충돌
+    tel_FALL, // 맵 아래로 떨어짐
+    tel_COIN, // 코인 획득
+    tel_CLEAR, // 스테이지 클리어
+    tel_HEATMAP // 위치 카운터 (뒤에 카운터 배열)
+} TelemetryType;
+
+// 기록 하나 (12바이트)
+typedef struct {
+    uint32_t tick; // 게임 루프 틱 번호
+    uint16_t type; // TelemetryType
+    uint16_t stage; // 스테이지 번호 (0부터)
+    uint16_t x, y; // 위치
+} TelemetryRecord;
+
+#endif // TELEMETRY_H
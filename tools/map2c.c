@@ -0,0 +1,209 @@
+// map.txt -> C 소스 변환기
+// 게임과 같은 규칙으로 map.txt를 읽어 스테이지 타일과 시작/적/코인 위치 테이블을
+// 읽기 전용 데이터로 출력한다. 출력 파일을 nuguri.c와 함께 -DEMBED_MAPS로 빌드하면
+// 실행 시 맵 파일 읽기와 동적 할당 없이 바로 게임을 시작할 수 있다.
+//
+// 사용법: map2c [입력 맵 파일(기본 map.txt)] [출력 C 파일(기본 표준 출력)]
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// 게임(nuguri.c)과 같은 맵 제한 크기
+#define LIMIT_WIDTH 256
+#define LIMIT_HEIGHT 256
+
+char ***map; // 3차원 배열 포인터 (stage, y, x)
+int map_width = 0; // 맵 가로 길이
+int map_height = 0; // 맵 세로 길이
+int stage_count = 0; // 전체 스테이지 개수
+
+// 한 줄 읽기 : 버퍼보다 긴 줄은 나머지를 버려서 다음 줄로 넘어가지 않게 함
+char *read_line(char *buf, int size, FILE *file) {
+    if (!fgets(buf, size, file)) return NULL;
+    if (strchr(buf, '\n') == NULL) {
+        int ch;
+        while ((ch = fgetc(file)) != EOF && ch != '\n'); // 줄의 나머지 버리기
+    }
+    return buf;
+}
+
+// 맵 파일 로드 (nuguri.c의 load_maps와 같은 방식)
+int load_maps(const char *path) {
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        perror(path);
+        return 0;
+    }
+    char buf[258]; // 한 줄을 읽을 버퍼 (제한 너비 256 + 개행 + NULL)
+    int max_width = 0; // 최대 너비
+    int max_height = 0; // 최대 높이
+    int current_height = 0; // 현재 스테이지 높이
+    int count = 1; // 최소 1 스테이지 존재
+
+    while(read_line(buf, sizeof(buf), file)) {
+        buf[strcspn(buf, "\r\n")] = 0; // 개행 문자 제거
+        int len = strlen(buf);
+
+        if(len == 0) { // 빈 줄(스테이지 구분)
+            if(current_height > 0) {
+                count++;
+                if(current_height > max_height) max_height = current_height;
+                current_height = 0;
+            }
+            continue;
+        }
+        if(len > max_width) max_width = len;
+        current_height++;
+    }
+    if(current_height > max_height) max_height = current_height;
+
+    // 맵 크기 제한 적용
+    if(max_width > LIMIT_WIDTH) {
+        max_width = LIMIT_WIDTH;
+        fprintf(stderr, "경고: 맵 너비가 제한을 초과하여 %d로 조정됩니다.\n", LIMIT_WIDTH);
+    }
+    if(max_height > LIMIT_HEIGHT) {
+        max_height = LIMIT_HEIGHT;
+        fprintf(stderr, "경고: 맵 높이가 제한을 초과하여 %d로 조정됩니다.\n", LIMIT_HEIGHT);
+    }
+
+    stage_count = count;
+    map_width = max_width;
+    map_height = max_height;
+
+    // 공백으로 채운 맵 할당
+    map = (char ***)malloc(sizeof(char **) * stage_count);
+    for(int i = 0; i < stage_count; i++) {
+        map[i] = (char **)malloc(sizeof(char *) * max_height);
+        for(int j = 0; j < max_height; j++) {
+            map[i][j] = (char *)malloc(sizeof(char) * max_width + 1);
+            memset(map[i][j], ' ', max_width);
+            map[i][j][max_width] = '\0';
+        }
+    }
+
+    rewind(file);
+
+    int s = 0, y = 0; // s: 스테이지 인덱스, y: 현재 스테이지 높이
+    while(read_line(buf, sizeof(buf), file) && s < stage_count) {
+        buf[strcspn(buf, "\r\n")] = 0;
+        int len = strlen(buf);
+
+        if(len == 0) {
+            if(y > 0) {
+                s++;
+                y = 0;
+            }
+            continue;
+        }
+        if(len > max_width) len = max_width; // 제한 너비를 넘는 부분은 버림
+        if(y < max_height) {
+            memcpy(map[s][y], buf, len);
+            y++;
+        }
+    }
+    fclose(file);
+    return 1;
+}
+
+// 한 줄을 C 문자열 리터럴로 출력
+void write_row(FILE *out, const char *row) {
+    fputc('"', out);
+    for(const char *p = row; *p; p++) {
+        if(*p == '"' || *p == '\\') fputc('\\', out); // 따옴표, 역슬래시 이스케이프
+        fputc(*p, out);
+    }
+    fputc('"', out);
+}
+
+// 스테이지에서 특정 문자의 위치 목록을 배열로 출력하고 개수를 반환
+int write_points(FILE *out, int s, char target, const char *name) {
+    int count = 0;
+    for(int y = 0; y < map_height; y++) {
+        for(int x = 0; x < map_width; x++) {
+            if(map[s][y][x] != target) continue;
+            if(count == 0) fprintf(out, "static const StagePoint stage%d_%s[] = {\n", s, name);
+            fprintf(out, "    {%d, %d},\n", x, y);
+            count++;
+        }
+    }
+    if(count > 0) fprintf(out, "};\n");
+    return count;
+}
+
+int main(int argc, char *argv[]) {
+    const char *in_path = (argc > 1) ? argv[1] : "map.txt";
+    FILE *out = stdout;
+
+    if(!load_maps(in_path)) return 1;
+    // 시작 위치 'S'가 없는 스테이지가 있으면 생성 중단 (벽 안에서 시작하는 맵이 내장되지 않도록)
+    for(int s = 0; s < stage_count; s++) {
+        int has_spawn = 0;
+        for(int y = 0; y < map_height && !has_spawn; y++) {
+            if(strchr(map[s][y], 'S')) has_spawn = 1;
+        }
+        if(!has_spawn) {
+            fprintf(stderr, "%s: 스테이지 %d에 시작 위치 'S'가 없습니다.\n", in_path, s + 1);
+            return 1;
+        }
+    }
+    if(argc > 2) {
+        out = fopen(argv[2], "w");
+        if(!out) {
+            perror(argv[2]);
+            return 1;
+        }
+    }
+
+    fprintf(out, "// map2c가 %s에서 자동 생성한 파일입니다. 직접 수정하지 마세요.\n", in_path);
+    fprintf(out, "#include \"stage_data.h\"\n\n");
+    fprintf(out, "const int embedded_map_width = %d;\n", map_width);
+    fprintf(out, "const int embedded_map_height = %d;\n", map_height);
+    fprintf(out, "const int embedded_stage_count = %d;\n\n", stage_count);
+
+    int *enemy_counts = (int *)malloc(sizeof(int) * stage_count);
+    int *coin_counts = (int *)malloc(sizeof(int) * stage_count);
+    for(int s = 0; s < stage_count; s++) {
+        // 타일
+        fprintf(out, "static const char *const stage%d_rows[] = {\n", s);
+        for(int y = 0; y < map_height; y++) {
+            fprintf(out, "    ");
+            write_row(out, map[s][y]);
+            fprintf(out, ",\n");
+        }
+        fprintf(out, "};\n");
+        // 적, 코인 위치
+        enemy_counts[s] = write_points(out, s, 'X', "enemies");
+        coin_counts[s] = write_points(out, s, 'C', "coins");
+        fprintf(out, "\n");
+    }
+
+    fprintf(out, "const char *const *const embedded_map[] = {\n");
+    for(int s = 0; s < stage_count; s++) fprintf(out, "    stage%d_rows,\n", s);
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "const StageData embedded_stages[] = {\n");
+    for(int s = 0; s < stage_count; s++) {
+        // 시작 위치 : 게임의 init_stage처럼 마지막으로 발견된 'S' 사용 (모든 스테이지에 있음을 위에서 확인)
+        int spawn_x = 0, spawn_y = 0;
+        for(int y = 0; y < map_height; y++) {
+            for(int x = 0; x < map_width; x++) {
+                if(map[s][y][x] == 'S') {
+                    spawn_x = x;
+                    spawn_y = y;
+                }
+            }
+        }
+        fprintf(out, "    { {%d, %d}, ", spawn_x, spawn_y);
+        if(enemy_counts[s] > 0) fprintf(out, "stage%d_enemies, %d, ", s, enemy_counts[s]);
+        else fprintf(out, "0, 0, ");
+        if(coin_counts[s] > 0) fprintf(out, "stage%d_coins, %d },\n", s, coin_counts[s]);
+        else fprintf(out, "0, 0 },\n");
+    }
+    fprintf(out, "};\n");
+
+    free(enemy_counts);
+    free(coin_counts);
+    if(out != stdout) fclose(out);
+    return 0;
+}
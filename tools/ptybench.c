@@ -0,0 +1,293 @@
+// 실제 게임 실행 파일 PTY 벤치마크 (Linux/macOS)
+// stagegen으로 만든 크기별 맵으로 nuguri를 의사 터미널에서 실행하고, 방향키 등 키 입력을 보낸 뒤
+// 출력되는 ANSI 화면을 읽어서 입력이 화면에 반영될 때까지의 지연 시간을 잰다.
+//
+// 측정 항목 (맵 크기별)
+//   - 키 입력 -> 플레이어(P) 위치가 바뀐 화면이 완성될 때까지의 지연 시간 백분위수
+//   - 화면 하나당 출력 바이트 수
+//   - 틱(화면) 하나당 게임 프로세스의 CPU 시간 (사용자 + 시스템)
+//
+// 사용법: ptybench [-b 게임 실행 파일(./nuguri)] [-g stagegen(./stagegen)]
+//                 [-s 크기 목록(40x15,80x30,160x60,255x200)] [-k 크기별 측정 키 수(40)]
+#define _GNU_SOURCE // memmem()
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <signal.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#if defined(__APPLE__)
+    #include <util.h> // forkpty()
+#else
+    #include <pty.h> // forkpty()
+#endif
+
+#define TICK_MS 90 // 게임 틱 간격 (nuguri.c의 delay(90))
+#define KEY_TIMEOUT_MS 1000 // 이 시간 안에 화면에 반영되지 않으면 실패로 셈
+#define FRAME_MARK "\033[2J\033[1;1HStage: " // 게임 화면의 시작 (clrscr + HUD)
+
+// 게임 출력 읽기 상태
+typedef struct {
+    int fd; // PTY master
+    int height; // 맵 높이 : 화면은 HUD 3줄 + 맵 height줄
+    char *buf; // 아직 처리하지 않은 출력
+    size_t len, cap;
+    unsigned long long total_bytes; // 지금까지 읽은 전체 바이트
+    unsigned long frames; // 완성된 화면 수
+    int player_x, player_y; // 마지막 화면의 P 위치
+    int title_seen; // 타이틀 화면을 봤는지
+    int closed; // 게임 종료 (EOF)
+} Screen;
+
+// 단조 시간 (ms)
+double now_ms() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+// 버퍼에서 완성된 화면을 찾아 P 위치를 갱신하고, 처리한 부분은 버림
+void parse_frames(Screen *sc) {
+    size_t mark_len = strlen(FRAME_MARK);
+    for (;;) {
+        char *start = NULL;
+        for (size_t i = 0; i + mark_len <= sc->len; i++) {
+            if (sc->buf[i] == '\033' && memcmp(sc->buf + i, FRAME_MARK, mark_len) == 0) {
+                start = sc->buf + i;
+                break;
+            }
+        }
+        if (start == NULL) {
+            if (!sc->title_seen && memmem(sc->buf, sc->len, "PRESS ENTER", 11)) sc->title_seen = 1;
+            // 표시 시작 문자열이 잘려서 들어왔을 수 있으므로 끝부분만 남김
+            if (sc->len >= mark_len) {
+                memmove(sc->buf, sc->buf + sc->len - (mark_len - 1), mark_len - 1);
+                sc->len = mark_len - 1;
+            }
+            return;
+        }
+
+        // HUD 3줄 + 맵 height줄이 모두 들어왔으면 화면 완성
+        char *end = sc->buf + sc->len;
+        int lines = 0, px = -1, py = -1, col = 0;
+        char *p = start + mark_len;
+        for (; p < end && lines < sc->height + 3; p++) {
+            if (*p == '\n') {
+                lines++;
+                col = 0;
+            } else if (*p != '\r') {
+                if (*p == 'P' && lines >= 3) {
+                    px = col;
+                    py = lines - 3;
+                }
+                col++;
+            }
+        }
+        if (lines < sc->height + 3) { // 아직 덜 들어옴
+            size_t offset = start - sc->buf;
+            memmove(sc->buf, start, sc->len - offset);
+            sc->len -= offset;
+            return;
+        }
+        sc->frames++;
+        if (px >= 0) {
+            sc->player_x = px;
+            sc->player_y = py;
+        }
+        size_t used = p - sc->buf;
+        memmove(sc->buf, p, sc->len - used);
+        sc->len -= used;
+    }
+}
+
+// 최대 timeout ms 동안 출력을 읽음. 새 화면이 완성되면 바로 반환
+void pump(Screen *sc, double timeout) {
+    double deadline = now_ms() + timeout;
+    unsigned long frames = sc->frames;
+    while (!sc->closed && sc->frames == frames) {
+        int wait = (int)(deadline - now_ms());
+        if (wait < 0) return;
+        struct pollfd pfd = {sc->fd, POLLIN, 0};
+        if (poll(&pfd, 1, wait) <= 0) continue;
+        if (sc->len + 65536 > sc->cap) {
+            sc->cap = (sc->len + 65536) * 2;
+            sc->buf = (char *)realloc(sc->buf, sc->cap);
+        }
+        ssize_t n = read(sc->fd, sc->buf + sc->len, sc->cap - sc->len);
+        if (n <= 0) { // 게임 종료 시 EIO
+            if (n < 0 && errno == EINTR) continue;
+            sc->closed = 1;
+            return;
+        }
+        sc->len += n;
+        sc->total_bytes += n;
+        parse_frames(sc);
+    }
+}
+
+// 키 입력 보내기
+void send_key(Screen *sc, const char *key) {
+    if (write(sc->fd, key, strlen(key)) < 0) sc->closed = 1;
+}
+
+int compare_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+double percentile(const double *sorted, int n, double p) {
+    if (n == 0) return 0;
+    int i = (int)(p / 100.0 * (n - 1) + 0.5);
+    return sorted[i];
+}
+
+// 한 크기에 대해 벤치마크 실행
+int run_size(const char *game, const char *gen, int width, int height, int keys) {
+    // 적, 코인 없는 맵 생성 (걷는 줄에는 장애물이 없어 좌우 이동이 항상 화면에 반영됨)
+    char map_path[] = "/tmp/ptybench_XXXXXX";
+    int map_fd = mkstemp(map_path);
+    if (map_fd < 0) {
+        perror("mkstemp");
+        return 0;
+    }
+    close(map_fd);
+    char command[512];
+    snprintf(command, sizeof(command), "%s -s 1 -n 1 -w %d -h %d -e 0 -c 0 -o %s", gen, width, height, map_path);
+    if (system(command) != 0) {
+        fprintf(stderr, "맵 생성 실패: %s\n", command);
+        unlink(map_path);
+        return 0;
+    }
+
+    // 게임 실행 : 화면이 잘리지 않도록 충분히 큰 터미널 크기 지정
+    struct winsize ws = {(unsigned short)(height + 10), (unsigned short)(width + 40), 0, 0};
+    Screen sc = {0};
+    sc.height = height;
+    pid_t pid = forkpty(&sc.fd, NULL, NULL, &ws);
+    if (pid < 0) {
+        perror("forkpty");
+        unlink(map_path);
+        return 0;
+    }
+    if (pid == 0) {
+        execl(game, game, "--map", map_path, (char *)NULL);
+        _exit(127);
+    }
+
+    // 타이틀 화면에서 ENTER, 첫 화면 대기
+    double deadline = now_ms() + 5000;
+    while (!sc.title_seen && !sc.closed && now_ms() < deadline) pump(&sc, 100);
+    send_key(&sc, "\n");
+    pump(&sc, 5000);
+    if (sc.frames == 0) {
+        fprintf(stderr, "%dx%d: 게임 화면을 받지 못했습니다.\n", width, height);
+        kill(pid, SIGKILL);
+        waitpid(pid, NULL, 0);
+        close(sc.fd);
+        unlink(map_path);
+        free(sc.buf);
+        return 0;
+    }
+
+    unsigned long long start_bytes = sc.total_bytes;
+    unsigned long start_frames = sc.frames;
+    double *latency = (double *)malloc(sizeof(double) * keys);
+    int measured = 0, missed = 0;
+    int dir = 1; // 1: 오른쪽, -1: 왼쪽
+
+    for (int i = 0; i < keys && !sc.closed; i++) {
+        // 양 끝에 닿으면 방향 전환. 방향키와 a/d를 번갈아 사용
+        if (sc.player_x >= width - 3) dir = -1;
+        if (sc.player_x <= 2) dir = 1;
+        const char *key = (dir > 0) ? ((i % 2) ? "d" : "\033[C") : ((i % 2) ? "a" : "\033[D");
+
+        // 틱과 맞물려 보내지 않도록 0 ~ 1틱 사이 임의의 시점에 입력 (실제 사람의 입력 시점처럼)
+        double phase = now_ms() + rand() % TICK_MS;
+        while (!sc.closed && now_ms() < phase) pump(&sc, phase - now_ms());
+
+        int before_x = sc.player_x;
+        double sent = now_ms();
+        send_key(&sc, key);
+        while (!sc.closed && sc.player_x == before_x && now_ms() - sent < KEY_TIMEOUT_MS) pump(&sc, KEY_TIMEOUT_MS);
+        if (sc.player_x != before_x) latency[measured++] = now_ms() - sent;
+        else missed++;
+
+        // 중간중간 위/아래 방향키도 보내서 네 방향키 처리 비용을 모두 포함
+        // 한 번에 써서 같은 틱에 읽히게 함 : 게임은 틱마다 마지막 키만 적용하므로 사다리 위에서도
+        // 아래 방향키만 적용되어 맨 아래층 바닥에 막혀 위치가 바뀌지 않음
+        if (i % 8 == 7) {
+            send_key(&sc, "\033[A\033[B");
+            pump(&sc, KEY_TIMEOUT_MS);
+        }
+    }
+    unsigned long frames = sc.frames - start_frames;
+    unsigned long long bytes = sc.total_bytes - start_bytes;
+
+    // 종료 후 게임 프로세스의 CPU 시간
+    send_key(&sc, "q");
+    while (!sc.closed) pump(&sc, 1000);
+    struct rusage ru;
+    int status;
+    wait4(pid, &status, 0, &ru);
+    double cpu_ms = ru.ru_utime.tv_sec * 1000.0 + ru.ru_utime.tv_usec / 1000.0
+                  + ru.ru_stime.tv_sec * 1000.0 + ru.ru_stime.tv_usec / 1000.0;
+
+    qsort(latency, measured, sizeof(double), compare_double);
+    printf("%4dx%-4d %7lu %10.0f %8.1f %8.1f %8.1f %8.1f %6d %10.1f\n", width, height, frames,
+           frames ? (double)bytes / frames : 0.0,
+           percentile(latency, measured, 50), percentile(latency, measured, 90),
+           percentile(latency, measured, 99), measured ? latency[measured - 1] : 0.0,
+           missed, sc.frames ? cpu_ms * 1000.0 / sc.frames : 0.0);
+
+    free(latency);
+    free(sc.buf);
+    close(sc.fd);
+    unlink(map_path);
+    return 1;
+}
+
+int main(int argc, char *argv[]) {
+    const char *game = "./nuguri";
+    const char *gen = "./stagegen";
+    const char *sizes = "40x15,80x30,160x60,255x200";
+    int keys = 40;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) {
+            fprintf(stderr, "사용법: %s [-b 게임] [-g stagegen] [-s 크기 목록] [-k 측정 키 수]\n", argv[0]);
+            return 1;
+        }
+        if (strcmp(argv[i], "-b") == 0) game = argv[++i];
+        else if (strcmp(argv[i], "-g") == 0) gen = argv[++i];
+        else if (strcmp(argv[i], "-s") == 0) sizes = argv[++i];
+        else if (strcmp(argv[i], "-k") == 0) keys = atoi(argv[++i]);
+        else {
+            fprintf(stderr, "알 수 없는 옵션: %s\n", argv[i]);
+            return 1;
+        }
+    }
+    if (keys < 1) keys = 1;
+    srand(1); // 입력 시점이 실행마다 같도록 고정 시드
+
+    printf("%-9s %7s %10s %8s %8s %8s %8s %6s %10s\n", "맵", "화면", "바이트/화면",
+           "p50(ms)", "p90(ms)", "p99(ms)", "최대(ms)", "실패", "CPU(us)/틱");
+    const char *p = sizes;
+    int ok = 1;
+    while (*p) {
+        int width, height, used;
+        if (sscanf(p, "%dx%d%n", &width, &height, &used) != 2 || width < 5 || height < 5) {
+            fprintf(stderr, "크기 형식이 올바르지 않습니다: %s\n", p);
+            return 1;
+        }
+        ok &= run_size(game, gen, width, height, keys);
+        p += used;
+        if (*p == ',') p++;
+    }
+    return ok ? 0 : 1;
+}
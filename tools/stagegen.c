@@ -0,0 +1,239 @@
+// map.txt 형식 스테이지 묶음 생성기 (부하/확장성 테스트용)
+// 같은 시드면 항상 같은 맵이 나오고, 한 줄씩 바로 출력하므로 스테이지 수나 맵 크기가
+// 커져도 사용하는 메모리는 맵 한 줄 크기로 일정하다.
+//
+// 맵 구조 (아래에서 위로)
+//   - 바닥(#) 위에 3칸 높이의 층이 반복되며, 층의 맨 아래 줄이 걸어 다니는 줄이다.
+//   - 맨 위층을 제외한 모든 층에는 윗층 바닥 바로 아래까지 이어지는 사다리(H)가 최소 1개 있다.
+//   - 플레이어(S)는 맨 아래층 왼쪽, 출구(E)는 맨 위층 오른쪽에 놓이므로 항상 E까지 갈 수 있다.
+//   - 게임이 읽는 최대 크기(256 x 256)를 넘으면 S나 E가 잘리므로 -w, -h는 256까지만 받는다.
+//   - 발판(#)은 걷는 줄과 사다리 칸을 피해 놓이므로 이동 경로를 막지 않는다.
+//   - 적(X), 코인(C)은 걷는 줄의 빈 칸 중에서 무작위로 정확히 지정한 개수만큼 놓인다.
+//   - S 오른쪽 SPAWN_GUARD칸, 필수 사다리의 아래/위 끝 좌우 LADDER_GUARD칸에는 적을 놓지 않아
+//     시작하자마자 적과 부딪히지 않는다. 다만 적은 걷는 줄 전체를 오가므로 -e가 0보다 크면
+//     E까지 도달한다는 보장은 없다. 자동 처리량 측정에는 -e 0을 사용한다.
+//
+// 사용법: stagegen [-s 시드] [-n 스테이지 수] [-w 너비] [-h 높이]
+//                 [-p 발판 밀도%] [-l 사다리 밀도%] [-e 적 수] [-c 코인 수] [-o 출력 파일]
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#define MAP_LIMIT 256 // 게임(nuguri.c)이 읽는 최대 너비/높이 : 넘으면 잘려서 S나 E가 사라짐
+#define SPAWN_GUARD 3 // S 오른쪽으로 적을 놓지 않는 칸 수
+#define LADDER_GUARD 2 // 필수 사다리 끝 좌우로 적을 놓지 않는 칸 수
+
+// 생성 옵션
+typedef struct {
+    unsigned long long seed; // 난수 시드
+    long stages; // 스테이지 수
+    int width, height; // 맵 크기
+    int platform_pct; // 빈 칸이 발판이 될 확률(%)
+    int ladder_pct; // 추가 사다리가 놓일 확률(%)
+    long enemies, coins; // 스테이지당 적, 코인 수
+} GenOption;
+
+// splitmix64 : 시드 섞기 + 난수 생성 (플랫폼과 관계없이 같은 결과)
+unsigned long long next_random(unsigned long long *state) {
+    unsigned long long z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// 0 ~ n-1 범위 난수
+long random_below(unsigned long long *state, long n) {
+    return (long)(next_random(state) % (unsigned long long)n);
+}
+
+// 스테이지/층마다 독립된 난수 상태 : 같은 층을 여러 번 다시 만들어도 결과가 같음
+unsigned long long layer_state(const GenOption *opt, long stage, int layer) {
+    unsigned long long state = opt->seed;
+    state ^= next_random(&state) + (unsigned long long)stage * 0xD1B54A32D192ED03ULL;
+    state ^= next_random(&state) + (unsigned long long)layer * 0x8CB92BA72F3D8DD7ULL;
+    return state;
+}
+
+// 층의 사다리 위치 생성 (ladder[x] = 1), 사다리 개수 반환
+// 맨 위층은 올라갈 곳이 없으므로 사다리를 놓지 않음
+int make_ladders(const GenOption *opt, int layer_count, int layer, unsigned long long *state, char *ladder) {
+    int w = opt->width;
+    int count = 0;
+    memset(ladder, 0, w);
+    if (layer == layer_count - 1) return 0;
+
+    ladder[2 + random_below(state, w - 4)] = 1; // 필수 사다리 : 양 끝(S, E 열)을 제외한 범위
+    for (int x = 2; x < w - 2; x++) {
+        if (random_below(state, 100) < opt->ladder_pct) ladder[x] = 1; // 추가 사다리
+    }
+    for (int x = 0; x < w; x++) count += ladder[x];
+    return count;
+}
+
+// 층의 필수 사다리 열 (make_ladders의 첫 난수와 같음), 사다리가 없는 층이면 -1
+int mandatory_ladder(const GenOption *opt, int layer_count, long stage, int layer) {
+    if (layer < 0 || layer >= layer_count - 1) return -1;
+    unsigned long long state = layer_state(opt, stage, layer);
+    return 2 + (int)random_below(&state, opt->width - 4);
+}
+
+// 걷는 줄의 (x, 층)에 적을 놓아도 되는지 : 시작 위치와 필수 사다리 양 끝 주변은 제외
+// ladder_here : 이 층에서 위로 가는 필수 사다리, ladder_below : 아래층에서 올라오는 필수 사다리
+int enemy_allowed(int layer, int x, int ladder_here, int ladder_below) {
+    if (layer == 0 && x <= 1 + SPAWN_GUARD) return 0;
+    if (ladder_here >= 0 && abs(x - ladder_here) <= LADDER_GUARD) return 0;
+    if (ladder_below >= 0 && abs(x - ladder_below) <= LADDER_GUARD) return 0;
+    return 1;
+}
+
+// 스테이지 하나를 한 줄씩 출력
+void write_stage(FILE *out, const GenOption *opt, long stage, char *row, char *ladder) {
+    int w = opt->width, h = opt->height;
+    int layer_count = (h - 1) / 4; // 바닥 1줄 + 빈 칸 3줄이 한 층
+    int top = h - 1 - layer_count * 4; // 1 ~ top 줄은 채워진 천장
+    unsigned long long state;
+
+    // 후보 칸 수 계산 : 코인은 걷는 줄의 빈 칸 (사다리, S, E 제외), 적은 그중 enemy_allowed인 칸
+    long coin_cells = 0, enemy_cells = 0;
+    for (int k = 0; k < layer_count; k++) {
+        int ladder_here = mandatory_ladder(opt, layer_count, stage, k);
+        int ladder_below = mandatory_ladder(opt, layer_count, stage, k - 1);
+        state = layer_state(opt, stage, k);
+        make_ladders(opt, layer_count, k, &state, ladder);
+        for (int x = 1; x < w - 1; x++) {
+            if (ladder[x] || (k == 0 && x == 1) || (k == layer_count - 1 && x == w - 2)) continue;
+            coin_cells++;
+            if (enemy_allowed(k, x, ladder_here, ladder_below)) enemy_cells++;
+        }
+    }
+
+    long enemies_left = opt->enemies, coins_left = opt->coins;
+    if (enemies_left > enemy_cells) enemies_left = enemy_cells;
+    if (coins_left > coin_cells - enemies_left) coins_left = coin_cells - enemies_left;
+    if (enemies_left < opt->enemies || coins_left < opt->coins) {
+        fprintf(stderr, "경고: 스테이지 %ld에 빈 칸이 부족해 적 %ld개, 코인 %ld개만 배치합니다.\n",
+                stage + 1, enemies_left, coins_left);
+    }
+    unsigned long long pick = layer_state(opt, stage, -1); // 적/코인 배치용 난수
+    int ladder_here = -1, ladder_below = -1; // 현재 층의 필수 사다리 위치
+
+    row[w] = '\n';
+    for (int y = 0; y < h; y++) {
+        int d = h - 1 - y; // 맨 아래 줄에서부터의 거리
+        int k = d / 4; // 층 번호 (0: 맨 아래층)
+        int a = d % 4; // 0: 바닥, 1: 걷는 줄, 2: 가운데 줄, 3: 위쪽 줄
+
+        memset(row, '#', w);
+        if (y == 0 || y <= top || a == 0) { // 테두리, 천장, 바닥
+            fwrite(row, 1, w + 1, out);
+            continue;
+        }
+        if (a == 3) { // 층의 첫 줄 : 이 층의 사다리와 발판 난수 준비
+            state = layer_state(opt, stage, k);
+            make_ladders(opt, layer_count, k, &state, ladder);
+            ladder_here = mandatory_ladder(opt, layer_count, stage, k);
+            ladder_below = mandatory_ladder(opt, layer_count, stage, k - 1);
+        }
+
+        for (int x = 1; x < w - 1; x++) {
+            if (ladder[x]) {
+                row[x] = 'H';
+            } else if (a != 1) {
+                row[x] = (random_below(&state, 100) < opt->platform_pct) ? '#' : ' ';
+            } else if (k == 0 && x == 1) {
+                row[x] = 'S';
+            } else if (k == layer_count - 1 && x == w - 2) {
+                row[x] = 'E';
+            } else {
+                // 남은 칸 중에서 정확히 지정한 개수만큼 뽑기 (순차 표본 추출)
+                // 적을 먼저 뽑고, 코인은 남은 적이 차지할 칸을 뺀 나머지 칸 중에서 뽑음
+                row[x] = ' ';
+                if (enemy_allowed(k, x, ladder_here, ladder_below)) {
+                    if (random_below(&pick, enemy_cells) < enemies_left) {
+                        row[x] = 'X';
+                        enemies_left--;
+                    }
+                    enemy_cells--;
+                }
+                if (row[x] == ' ' && random_below(&pick, coin_cells - enemies_left) < coins_left) {
+                    row[x] = 'C';
+                    coins_left--;
+                }
+                coin_cells--;
+            }
+        }
+        fwrite(row, 1, w + 1, out);
+    }
+}
+
+// 숫자 옵션 읽기 (min ~ max 범위)
+long read_number(const char *name, const char *value, long min, long max) {
+    char *end;
+    long n = strtol(value, &end, 10);
+    if (*end != '\0' || n < min || n > max) {
+        fprintf(stderr, "%s 값이 올바르지 않습니다: %s (%ld ~ %ld)\n", name, value, min, max);
+        exit(1);
+    }
+    return n;
+}
+
+int main(int argc, char *argv[]) {
+    GenOption opt = {1, 1, 40, 15, 20, 10, 3, 8}; // 기본값 : map.txt와 비슷한 크기
+    const char *out_path = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (argv[i][0] != '-' || argv[i][1] == '\0' || argv[i][2] != '\0' || i + 1 >= argc) {
+            fprintf(stderr, "사용법: %s [-s 시드] [-n 스테이지 수] [-w 너비] [-h 높이] "
+                            "[-p 발판 밀도%%] [-l 사다리 밀도%%] [-e 적 수] [-c 코인 수] [-o 출력 파일]\n", argv[0]);
+            return 1;
+        }
+        const char *value = argv[++i];
+        switch (argv[i - 1][1]) {
+            case 's': opt.seed = strtoull(value, NULL, 10); break;
+            case 'n': opt.stages = read_number("-n", value, 1, LONG_MAX); break;
+            case 'w': opt.width = (int)read_number("-w", value, 5, MAP_LIMIT); break;
+            case 'h': opt.height = (int)read_number("-h", value, 5, MAP_LIMIT); break;
+            case 'p': opt.platform_pct = (int)read_number("-p", value, 0, 100); break;
+            case 'l': opt.ladder_pct = (int)read_number("-l", value, 0, 100); break;
+            case 'e': opt.enemies = read_number("-e", value, 0, LONG_MAX); break;
+            case 'c': opt.coins = read_number("-c", value, 0, LONG_MAX); break;
+            case 'o': out_path = value; break;
+            default:
+                fprintf(stderr, "알 수 없는 옵션: %s\n", argv[i - 1]);
+                return 1;
+        }
+    }
+
+    FILE *out = stdout;
+    if (out_path) {
+        out = fopen(out_path, "wb");
+        if (!out) {
+            perror(out_path);
+            return 1;
+        }
+    }
+    static char out_buf[1 << 16]; // 큰 출력 버퍼로 쓰기 횟수 감소
+    setvbuf(out, out_buf, _IOFBF, sizeof(out_buf));
+
+    // 한 줄 버퍼(개행 포함)와 층의 사다리 위치만 사용
+    char *row = (char *)malloc(opt.width + 1);
+    char *ladder = (char *)malloc(opt.width);
+    if (!row || !ladder) {
+        fprintf(stderr, "메모리가 부족합니다.\n");
+        return 1;
+    }
+
+    for (long s = 0; s < opt.stages; s++) {
+        if (s > 0) fputc('\n', out); // 빈 줄로 스테이지 구분
+        write_stage(out, &opt, s, row, ladder);
+    }
+
+    free(row);
+    free(ladder);
+    if (fclose(out) != 0) {
+        perror("출력 실패");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,177 @@
+// 게임 기록(--telemetry) 합산기
+// 여러 세션의 기록 파일을 읽어 스테이지별 위치 카운터와 이벤트(사망, 낙하, 코인, 클리어)를 합친다.
+// 맵 크기가 처음 세션과 다른 세션은 건너뛴다.
+//
+// 사용법: tlmagg [-c] 기록파일...
+//   기본 : 스테이지별 이벤트 합계와 머문 시간 분포를 문자 지도로 출력
+//   -c   : 칸별 합계를 CSV(stage,x,y,ticks,deaths,falls,coins,clears)로 출력
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../telemetry.h"
+
+#define EVENT_KINDS 4 // 사망, 낙하, 코인, 클리어
+
+// 스테이지별 합계
+typedef struct {
+    unsigned long long *ticks; // 칸별 머문 틱 수 [y][x]
+    unsigned long *events[EVENT_KINDS]; // 칸별 이벤트 수 [y][x]
+    unsigned long totals[EVENT_KINDS]; // 이벤트 합계
+    unsigned long long total_ticks; // 머문 틱 합계
+} StageSum;
+
+int map_width = 0, map_height = 0; // 첫 세션의 맵 크기
+int stage_count = 0; // 지금까지 본 가장 많은 스테이지 수
+StageSum *stages = NULL;
+unsigned long sessions = 0, skipped = 0; // 합친 세션 수, 건너뛴 세션 수
+
+// 메모리 부족 시 중단
+void *check_alloc(void *ptr) {
+    if (ptr == NULL) {
+        fprintf(stderr, "메모리가 부족합니다.\n");
+        exit(1);
+    }
+    return ptr;
+}
+
+// 스테이지 배열을 count개까지 늘림
+void grow_stages(int count) {
+    if (count <= stage_count) return;
+    size_t cells = (size_t)map_width * map_height;
+    stages = (StageSum *)check_alloc(realloc(stages, sizeof(StageSum) * count));
+    for (int s = stage_count; s < count; s++) {
+        memset(&stages[s], 0, sizeof(StageSum));
+        stages[s].ticks = (unsigned long long *)check_alloc(calloc(cells, sizeof(unsigned long long)));
+        for (int k = 0; k < EVENT_KINDS; k++) stages[s].events[k] = (unsigned long *)check_alloc(calloc(cells, sizeof(unsigned long)));
+        stage_count = s + 1; // 중간에 중단되어도 해제할 수 있도록 하나씩 늘림
+    }
+}
+
+// 기록 파일 하나 읽기
+void read_file(const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        perror(path);
+        return;
+    }
+    TelemetryRecord rec;
+    int use = 0; // 1: 현재 세션을 합계에 반영
+    int session_stages = 0;
+    uint32_t *counts = NULL; // 위치 카운터 읽기 버퍼 (맵 크기만큼)
+
+    while (fread(&rec, sizeof(rec), 1, file) == 1) {
+        if (rec.type == tel_SESSION) {
+            if (rec.tick != TELEMETRY_MAGIC || rec.x == 0 || rec.y == 0) break; // 기록 파일이 아님
+            if (map_width == 0) { // 첫 세션의 맵 크기를 기준으로 삼음
+                map_width = rec.x;
+                map_height = rec.y;
+            }
+            use = (rec.x == map_width && rec.y == map_height);
+            session_stages = rec.stage;
+            if (use) {
+                grow_stages(session_stages);
+                sessions++;
+            } else {
+                skipped++;
+            }
+        } else if (rec.type == tel_HEATMAP) {
+            // 카운터 개수는 기록의 x*y : 맵 크기가 다르면 합칠 수 없으므로 읽지 않고 건너뜀
+            size_t cells = (size_t)rec.x * rec.y;
+            if (!use || rec.stage >= session_stages || rec.x != map_width || rec.y != map_height) {
+                if (fseek(file, (long)(cells * sizeof(uint32_t)), SEEK_CUR) != 0) break;
+                continue;
+            }
+            if (counts == NULL) counts = (uint32_t *)check_alloc(malloc(cells * sizeof(uint32_t)));
+            if (fread(counts, sizeof(uint32_t), cells, file) != cells) break; // 잘린 파일
+            StageSum *sum = &stages[rec.stage];
+            for (size_t i = 0; i < cells; i++) {
+                sum->ticks[i] += counts[i];
+                sum->total_ticks += counts[i];
+            }
+        } else if (rec.type >= tel_DEATH && rec.type <= tel_CLEAR) {
+            if (!use || rec.stage >= session_stages || rec.x >= map_width || rec.y >= map_height) continue;
+            int kind = rec.type - tel_DEATH;
+            stages[rec.stage].events[kind][(size_t)rec.y * map_width + rec.x]++;
+            stages[rec.stage].totals[kind]++;
+        } else {
+            fprintf(stderr, "%s: 알 수 없는 기록이 있어 나머지를 건너뜁니다.\n", path);
+            break;
+        }
+    }
+    free(counts);
+    fclose(file);
+}
+
+// 스테이지별 요약과 문자 지도 출력 (머문 시간이 길수록 진한 문자, 사망/낙하가 있는 칸은 '!')
+void print_summary() {
+    const char *shade = " .:-=+*#%@";
+    printf("세션 %lu개 합산 (맵 크기가 달라 건너뛴 세션 %lu개), 맵 %d x %d\n", sessions, skipped, map_width, map_height);
+    for (int s = 0; s < stage_count; s++) {
+        StageSum *sum = &stages[s];
+        unsigned long long max = 0;
+        for (size_t i = 0; i < (size_t)map_width * map_height; i++) {
+            if (sum->ticks[i] > max) max = sum->ticks[i];
+        }
+        printf("\nStage %d : 틱 %llu, 사망 %lu, 낙하 %lu, 코인 %lu, 클리어 %lu\n", s + 1, sum->total_ticks,
+               sum->totals[0], sum->totals[1], sum->totals[2], sum->totals[3]);
+        for (int y = 0; y < map_height; y++) {
+            for (int x = 0; x < map_width; x++) {
+                size_t i = (size_t)y * map_width + x;
+                if (sum->events[0][i] || sum->events[1][i]) {
+                    putchar('!');
+                } else if (sum->ticks[i] == 0 || max == 0) {
+                    putchar(' ');
+                } else {
+                    int level = 1 + (int)(8 * log((double)sum->ticks[i]) / log((double)max + 1)); // 로그 스케일
+                    putchar(shade[level > 9 ? 9 : level]);
+                }
+            }
+            putchar('\n');
+        }
+    }
+}
+
+// 칸별 CSV 출력 (기록이 있는 칸만)
+void print_csv() {
+    printf("stage,x,y,ticks,deaths,falls,coins,clears\n");
+    for (int s = 0; s < stage_count; s++) {
+        StageSum *sum = &stages[s];
+        for (int y = 0; y < map_height; y++) {
+            for (int x = 0; x < map_width; x++) {
+                size_t i = (size_t)y * map_width + x;
+                if (!sum->ticks[i] && !sum->events[0][i] && !sum->events[1][i] && !sum->events[2][i] && !sum->events[3][i]) continue;
+                printf("%d,%d,%d,%llu,%lu,%lu,%lu,%lu\n", s + 1, x, y, sum->ticks[i],
+                       sum->events[0][i], sum->events[1][i], sum->events[2][i], sum->events[3][i]);
+            }
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    int csv = 0;
+    int files = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-c") == 0) {
+            csv = 1;
+            continue;
+        }
+        read_file(argv[i]);
+        files++;
+    }
+    if (files == 0) {
+        fprintf(stderr, "사용법: %s [-c] 기록파일...\n", argv[0]);
+        return 1;
+    }
+
+    if (csv) print_csv();
+    else print_summary();
+
+    for (int s = 0; s < stage_count; s++) {
+        free(stages[s].ticks);
+        for (int k = 0; k < EVENT_KINDS; k++) free(stages[s].events[k]);
+    }
+    free(stages);
+    return 0;
+}